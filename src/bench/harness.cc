@@ -0,0 +1,57 @@
+#include "harness.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+
+namespace bench
+{
+Summary summarize(std::vector<double> samples)
+{
+    Summary summary = {0, 0, 0, 0, 0};
+
+    if (samples.empty())
+        return summary;
+
+    std::sort(samples.begin(), samples.end());
+
+    size_t n = samples.size();
+    double sum = 0;
+
+    for (double s : samples)
+        sum += s;
+
+    summary.mean = sum / n;
+    summary.median = (n % 2) ? samples[n / 2] : (samples[n / 2 - 1] + samples[n / 2]) / 2;
+    summary.min = samples.front();
+    summary.max = samples.back();
+
+    double squares = 0;
+
+    for (double s : samples)
+        squares += (s - summary.mean) * (s - summary.mean);
+
+    summary.stddev = (n > 1) ? std::sqrt(squares / (n - 1)) : 0;
+
+    return summary;
+}
+
+CsvWriter::CsvWriter(std::ostream &stream, const Settings &settings)
+    : stream_(stream), settings_(settings) {}
+
+void CsvWriter::write_header()
+{
+    stream_ << "suite,case,algorithm,frames,processes,jobmix,operations,warmup,reps,"
+            << "metric,mean,median,min,max,stddev" << std::endl;
+}
+
+void CsvWriter::write_row(const Case &c, const std::string &metric, const Summary &summary)
+{
+    stream_ << c.suite << ',' << c.name << ',' << c.algorithm << ','
+            << c.frames << ',' << c.processes << ',' << c.jobmix << ','
+            << c.operations << ',' << settings_.warmup << ',' << settings_.reps << ','
+            << metric << std::setprecision(6)
+            << ',' << summary.mean << ',' << summary.median << ',' << summary.min
+            << ',' << summary.max << ',' << summary.stddev << std::endl;
+}
+} // namespace bench
@@ -0,0 +1,94 @@
+#ifndef H_BENCH_HARNESS
+#define H_BENCH_HARNESS
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace bench
+{
+struct Settings
+{
+    int warmup;     /* discarded repetitions before measuring */
+    int reps;       /* measured repetitions */
+    int max_frames; /* largest frame count of the pager suites */
+    bool quick;     /* smaller workloads, for a fast smoke run */
+    std::vector<std::string> algorithms;
+
+    Settings() : warmup(1), reps(5), max_frames(1000000), quick(false){};
+};
+
+/* Distribution of one metric over the measured repetitions. */
+struct Summary
+{
+    double mean;
+    double median;
+    double min;
+    double max;
+    double stddev;
+};
+
+Summary summarize(std::vector<double> samples);
+
+/* Identifies what a CSV row measured. Fields that do not apply are left at -1. */
+struct Case
+{
+    std::string suite;
+    std::string name;
+    std::string algorithm;
+    int frames;
+    int processes;
+    int jobmix;
+    long long operations; /* operations timed per repetition */
+
+    Case(const std::string &suite, const std::string &name)
+        : suite(suite), name(name), algorithm("-"), frames(-1), processes(-1), jobmix(-1),
+          operations(0){};
+};
+
+/**
+ * Writes one row per (case, metric) to stream:
+ *
+ *      suite,case,algorithm,frames,processes,jobmix,operations,warmup,reps,metric,mean,median,min,max,stddev
+ */
+class CsvWriter
+{
+public:
+    CsvWriter(std::ostream &stream, const Settings &settings);
+
+    void write_header();
+    void write_row(const Case &c, const std::string &metric, const Summary &summary);
+
+private:
+    std::ostream &stream_;
+    const Settings &settings_;
+};
+
+/**
+ * Runs sample() settings.warmup times without keeping the result, then
+ * settings.reps times, and summarizes the values it returned.
+ */
+template <class Sample>
+Summary measure(const Settings &settings, Sample sample)
+{
+    for (int i = 0; i < settings.warmup; i++)
+        sample();
+
+    std::vector<double> samples;
+
+    for (int i = 0; i < settings.reps; i++)
+        samples.push_back(sample());
+
+    return summarize(samples);
+}
+
+/* Seconds elapsed since start. */
+inline double seconds_since(std::chrono::steady_clock::time_point start)
+{
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+} // namespace bench
+
+#endif
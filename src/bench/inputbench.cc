@@ -0,0 +1,153 @@
+#include "inputbench.h"
+
+#include <fstream>
+#include <iterator>
+#include <memory>
+
+#include "../driver/driver.h"
+#include "../driver/jobmixspec.h"
+#include "../driver/jobmix.h"
+#include "../io/randintreader.h"
+#include "../io/randnumloader.h"
+#include "../io/randsource.h"
+#include "../io/uin.h"
+#include "../pager/refsink.h"
+
+namespace bench
+{
+
+namespace
+{
+
+/* Drops every reference; keeps a count so the generator's work is observable. */
+class CountingSink : public pager::ReferenceSink
+{
+public:
+    CountingSink() : count_(0) {}
+
+    void reference_by_virtual_addr(int viraddr, int pid, int time_accessed) override { count_++; }
+
+    long long count() const { return count_; }
+
+private:
+    long long count_;
+};
+
+double time_draws(io::RandIntReader &reader, int draws)
+{
+    long long sum = 0;
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < draws; i++)
+        sum += reader.read_next_int();
+
+    double seconds = seconds_since(start);
+
+    if (sum < 0)
+        std::cerr << "unreachable" << std::endl;
+
+    return seconds * 1e9 / draws;
+}
+
+} // namespace
+
+void run_random_numbers(const Settings &settings, const std::string &randfile, CsvWriter &csv)
+{
+    std::ifstream infile(randfile, std::ios::binary);
+
+    if (!infile)
+    {
+        std::cout << "An error occured opening the random number file. Terminating..." << std::endl;
+        exit(10);
+    }
+
+    std::string text((std::istreambuf_iterator<char>(infile)), std::istreambuf_iterator<char>());
+
+    std::vector<int> numbers;
+    io::parse_random_numbers(text.data(), text.data() + text.size(), numbers);
+    const long long count = (long long)numbers.size();
+
+    Summary parse = measure(settings, [&]() {
+        std::vector<int> parsed;
+        parsed.reserve(count);
+
+        auto start = std::chrono::steady_clock::now();
+        io::parse_random_numbers(text.data(), text.data() + text.size(), parsed);
+        return text.size() / seconds_since(start) / 1e6;
+    });
+
+    Case parse_case("random-numbers", "parse");
+    parse_case.operations = count;
+    csv.write_row(parse_case, "mb_per_sec", parse);
+
+    Summary load = measure(settings, [&]() {
+        std::vector<int> loaded;
+
+        auto start = std::chrono::steady_clock::now();
+        io::load_random_numbers(randfile, loaded);
+        return seconds_since(start) * 1e9 / count;
+    });
+
+    Case load_case("random-numbers", "load-cached");
+    load_case.operations = count;
+    csv.write_row(load_case, "ns_per_number", load);
+
+    std::shared_ptr<const std::vector<int>> shared = std::make_shared<const std::vector<int>>(numbers);
+
+    Summary file_draws = measure(settings, [&]() {
+        io::RandIntReader reader(std::unique_ptr<io::RandomSource>(new io::FileRandomSource(shared)), false);
+        return time_draws(reader, (int)count);
+    });
+
+    Case file_case("random-numbers", "draw-file");
+    file_case.operations = count;
+    csv.write_row(file_case, "ns_per_number", file_draws);
+
+    const int draws = settings.quick ? 100000 : 1000000;
+
+    Summary counter_draws = measure(settings, [&]() {
+        io::RandIntReader reader(std::unique_ptr<io::RandomSource>(new io::CounterRandomSource(0, 0)), false);
+        return time_draws(reader, draws);
+    });
+
+    Case counter_case("random-numbers", "draw-splitmix64");
+    counter_case.operations = draws;
+    csv.write_row(counter_case, "ns_per_number", counter_draws);
+}
+
+void run_reference_generation(const Settings &settings, CsvWriter &csv)
+{
+    const int ref_count = settings.quick ? 10000 : 100000;
+
+    for (int jobmix = 1; jobmix <= 4; jobmix++)
+    {
+        io::UserInput config;
+        config.machine_size = 200;
+        config.page_size = 10;
+        config.proc_size = 1000;
+        config.jobmix = jobmix;
+        config.ref_count = ref_count;
+        config.rng = io::RNG_COUNTER;
+
+        int processes = driver::jobmixspecs::get_jobmix(jobmix)->process_count();
+        long long refs = (long long)ref_count * processes;
+
+        Summary summary = measure(settings, [&]() {
+            io::RandIntReader reader(io::make_random_source(config), false);
+            CountingSink sink;
+            driver::Driver driver(config, sink, reader);
+
+            auto start = std::chrono::steady_clock::now();
+            driver.execute();
+            return sink.count() / seconds_since(start);
+        });
+
+        Case c("reference-generation", "driver");
+        c.processes = processes;
+        c.jobmix = jobmix;
+        c.operations = refs;
+        csv.write_row(c, "refs_per_sec", summary);
+    }
+}
+} // namespace bench
@@ -0,0 +1,19 @@
+#ifndef H_BENCH_INPUTBENCH
+#define H_BENCH_INPUTBENCH
+
+#include "harness.h"
+
+namespace bench
+{
+/**
+ * Random number input: parsing the text of the random number file, loading it
+ * through the binary sidecar cache, and drawing numbers through RandIntReader
+ * from the file and from the splitmix64 generator.
+ */
+void run_random_numbers(const Settings &settings, const std::string &randfile, CsvWriter &csv);
+
+/* References per second of driver::Driver alone, into a sink that drops them, per job mix. */
+void run_reference_generation(const Settings &settings, CsvWriter &csv);
+} // namespace bench
+
+#endif
@@ -0,0 +1,121 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "harness.h"
+#include "inputbench.h"
+#include "pagerbench.h"
+#include "../io/uin.h"
+
+namespace
+{
+
+const char *ALL_ALGORITHMS_[] = {"fifo", "random", "lru", "opt", "clock", "esc", "gclock",
+                                 "arc", "2q", "lirs"};
+
+void print_usage()
+{
+    std::cout << "Usage: ./bench [--suite=all|micro|macro|threads|input] [--reps=N] [--warmup=N]\n"
+              << "               [--max-frames=N] [--algos=lru,fifo,...] [--randfile=PATH] [--quick]\n"
+              << "Writes CSV to standard output." << std::endl;
+}
+
+int parse_count(const std::string &value, int min)
+{
+    int count = min - 1;
+
+    try
+    {
+        count = std::stoi(value);
+    }
+    catch (const std::exception &e)
+    {
+    }
+
+    if (count < min)
+    {
+        std::cout << "Invalid benchmark option value `" << value << "`. Terminating..." << std::endl;
+        exit(10);
+    }
+
+    return count;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    bench::Settings settings;
+    std::string suite = "all";
+    std::string randfile = io::UserInput().randfile;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        size_t eq = arg.find('=');
+        std::string name = arg.substr(0, eq);
+        std::string value = (eq == std::string::npos) ? "" : arg.substr(eq + 1);
+
+        if (name == "--quick")
+            settings.quick = true;
+        else if (name == "--suite")
+            suite = value;
+        else if (name == "--reps")
+            settings.reps = parse_count(value, 1);
+        else if (name == "--warmup")
+            settings.warmup = parse_count(value, 0);
+        else if (name == "--max-frames")
+            settings.max_frames = parse_count(value, 10);
+        else if (name == "--randfile")
+            randfile = value;
+        else if (name == "--algos")
+        {
+            std::istringstream iss(value);
+            std::string algorithm;
+
+            while (std::getline(iss, algorithm, ','))
+            {
+                io::map_to_algoname(algorithm); /* exits on an unknown name */
+                settings.algorithms.push_back(algorithm);
+            }
+        }
+        else
+        {
+            print_usage();
+            return 10;
+        }
+    }
+
+    if (suite != "all" && suite != "micro" && suite != "macro" && suite != "threads" &&
+        suite != "input")
+    {
+        print_usage();
+        return 10;
+    }
+
+    if (settings.algorithms.empty())
+        settings.algorithms.assign(std::begin(ALL_ALGORITHMS_), std::end(ALL_ALGORITHMS_));
+
+    if (settings.quick && settings.max_frames > 10000)
+        settings.max_frames = 10000;
+
+    bench::CsvWriter csv(std::cout, settings);
+    csv.write_header();
+
+    if (suite == "all" || suite == "input")
+    {
+        bench::run_random_numbers(settings, randfile, csv);
+        bench::run_reference_generation(settings, csv);
+    }
+
+    if (suite == "all" || suite == "micro")
+        bench::run_pager_micro(settings, csv);
+
+    if (suite == "all" || suite == "macro")
+        bench::run_pager_macro(settings, csv);
+
+    if (suite == "all" || suite == "threads")
+        bench::run_pager_threads(settings, csv);
+
+    return 0;
+}
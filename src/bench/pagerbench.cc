@@ -0,0 +1,272 @@
+#include "pagerbench.h"
+
+#include <algorithm>
+#include <memory>
+#include <thread>
+
+#include "../driver/driver.h"
+#include "../driver/jobmixspec.h"
+#include "../driver/jobmix.h"
+#include "../driver/multicpudriver.h"
+#include "../io/randintreader.h"
+#include "../io/randsource.h"
+#include "../io/uin.h"
+#include "../pager/pager.h"
+#include "../pager/pagerfactory.h"
+#include "../pager/shardedpager.h"
+#include "../trace/nextuse.h"
+#include "../trace/tracebuffer.h"
+
+namespace bench
+{
+
+namespace
+{
+
+const int MICRO_PID_ = 1;
+
+std::vector<int> frame_counts(const Settings &settings, int limit)
+{
+    std::vector<int> counts;
+
+    for (long long frames = 10; frames <= std::min(settings.max_frames, limit); frames *= 10)
+        counts.push_back((int)frames);
+
+    return counts;
+}
+
+io::UserInput micro_config(const std::string &algorithm, int frames)
+{
+    /* One word per page, so that a virtual address is a page id */
+    io::UserInput config;
+    config.machine_size = frames;
+    config.page_size = 1;
+    config.proc_size = frames;
+    config.jobmix = 1;
+    config.ref_count = 0;
+    config.raw_algoname = algorithm;
+    config.algoname = io::map_to_algoname(algorithm);
+    config.rng = io::RNG_COUNTER;
+    return config;
+}
+
+/**
+ * Loads pages 0 .. frames - 1, then appends ops measured references: to
+ * resident pages in a scattered order for hits, to fresh pages for faults.
+ */
+std::vector<trace::TraceRecord> micro_stream(int frames, int ops, bool hits)
+{
+    std::vector<trace::TraceRecord> stream;
+    stream.reserve(frames + ops);
+
+    int time = 0;
+
+    for (int page = 0; page < frames; page++)
+    {
+        trace::TraceRecord record = {MICRO_PID_, page, ++time};
+        stream.push_back(record);
+    }
+
+    for (int i = 0; i < ops; i++)
+    {
+        int page = hits ? (int)(((uint64_t)i * 2654435761u) % frames) : frames + i;
+        trace::TraceRecord record = {MICRO_PID_, page, ++time};
+        stream.push_back(record);
+    }
+
+    return stream;
+}
+
+double time_micro_stream(const io::UserInput &config, const std::vector<trace::TraceRecord> &stream,
+                         const std::vector<uint64_t> &next_use, int frames, int expected_faults)
+{
+    io::RandIntReader reader(std::unique_ptr<io::RandomSource>(new io::CounterRandomSource(0, 0)), false);
+    std::unique_ptr<pager::PagerBase> pager = pager::make_pager(config, reader, &next_use);
+
+    for (int i = 0; i < frames; i++)
+        pager->reference_by_virtual_addr(stream[i].viraddr, stream[i].pid, stream[i].time_accessed);
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (size_t i = frames; i < stream.size(); i++)
+        pager->reference_by_virtual_addr(stream[i].viraddr, stream[i].pid, stream[i].time_accessed);
+
+    double seconds = seconds_since(start);
+
+    int faults = pager->process_stats().at(MICRO_PID_).page_fault_count;
+
+    if (faults != expected_faults)
+    {
+        std::cerr << "warning: " << config.raw_algoname << " with " << frames << " frames took "
+                  << faults << " faults, expected " << expected_faults << std::endl;
+    }
+
+    return seconds * 1e9 / (stream.size() - frames);
+}
+
+int process_count(int jobmix)
+{
+    return driver::jobmixspecs::get_jobmix(jobmix)->process_count();
+}
+
+double time_simulation(const io::UserInput &config)
+{
+    io::RandIntReader reader(io::make_random_source(config), false);
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::unique_ptr<pager::PagerBase> pager;
+
+    if (config.algoname == pager::OPT)
+    {
+        trace::TraceBuffer generated;
+        driver::Driver generator(config, generated, reader);
+        generator.execute();
+
+        std::vector<uint64_t> next_use = trace::compute_next_use(generated.begin(), generated.end(),
+                                                                 config.page_size);
+        pager = pager::make_pager(config, reader, &next_use);
+        generated.replay(*pager);
+    }
+    else
+    {
+        pager = pager::make_pager(config, reader);
+        driver::Driver driver(config, *pager, reader);
+        driver.execute();
+    }
+
+    return seconds_since(start);
+}
+
+} // namespace
+
+void run_pager_micro(const Settings &settings, CsvWriter &csv)
+{
+    const int ops = settings.quick ? 20000 : 200000;
+
+    for (auto &algorithm : settings.algorithms)
+    {
+        for (int frames : frame_counts(settings, 1000000))
+        {
+            io::UserInput config = micro_config(algorithm, frames);
+
+            for (int pass = 0; pass < 2; pass++)
+            {
+                bool hits = (pass == 0);
+
+                std::vector<trace::TraceRecord> stream = micro_stream(frames, ops, hits);
+                std::vector<uint64_t> next_use = trace::compute_next_use(
+                    stream.data(), stream.data() + stream.size(), config.page_size);
+
+                int expected_faults = hits ? frames : frames + ops;
+
+                Summary summary = measure(settings, [&]() {
+                    return time_micro_stream(config, stream, next_use, frames, expected_faults);
+                });
+
+                Case c("pager-micro", hits ? "hit" : "fault");
+                c.algorithm = algorithm;
+                c.frames = frames;
+                c.processes = 1;
+                c.operations = ops;
+                csv.write_row(c, hits ? "ns_per_hit" : "ns_per_fault", summary);
+            }
+        }
+    }
+}
+
+void run_pager_macro(const Settings &settings, CsvWriter &csv)
+{
+    const int page_size = 10;
+    const int ref_count = settings.quick ? 2000 : 20000;
+
+    for (auto &algorithm : settings.algorithms)
+    {
+        for (int frames : frame_counts(settings, settings.quick ? 1000 : 10000))
+        {
+            for (int jobmix = 1; jobmix <= 4; jobmix++)
+            {
+                /* Every process may touch as many pages as there are frames */
+                io::UserInput config;
+                config.machine_size = frames * page_size;
+                config.page_size = page_size;
+                config.proc_size = frames * page_size;
+                config.jobmix = jobmix;
+                config.ref_count = ref_count;
+                config.raw_algoname = algorithm;
+                config.algoname = io::map_to_algoname(algorithm);
+                config.rng = io::RNG_COUNTER;
+
+                long long refs = (long long)ref_count * process_count(jobmix);
+
+                Summary summary = measure(settings, [&]() { return refs / time_simulation(config); });
+
+                Case c("pager-macro", "simulation");
+                c.algorithm = algorithm;
+                c.frames = frames;
+                c.processes = process_count(jobmix);
+                c.jobmix = jobmix;
+                c.operations = refs;
+                csv.write_row(c, "refs_per_sec", summary);
+            }
+        }
+    }
+}
+
+void run_pager_threads(const Settings &settings, CsvWriter &csv)
+{
+    const int page_size = 10;
+    const int jobmix = 4;
+    const int ref_count = settings.quick ? 20000 : 200000;
+    const int max_cpus = std::max(4, (int)std::thread::hardware_concurrency());
+
+    io::CpuMode modes[] = {io::CPU_DETERMINISTIC, io::CPU_RELAXED};
+
+    for (auto &algorithm : settings.algorithms)
+    {
+        if (io::map_to_algoname(algorithm) == pager::OPT)
+            continue;
+
+        int frames = std::min(settings.max_frames, settings.quick ? 1000 : 10000);
+
+        for (io::CpuMode mode : modes)
+        {
+            for (int cpus = 1; cpus <= max_cpus; cpus *= 2)
+            {
+                io::UserInput config;
+                config.machine_size = frames * page_size;
+                config.page_size = page_size;
+                config.proc_size = frames * page_size;
+                config.jobmix = jobmix;
+                config.ref_count = ref_count;
+                config.raw_algoname = algorithm;
+                config.algoname = io::map_to_algoname(algorithm);
+                config.rng = io::RNG_COUNTER;
+                config.cpus = cpus;
+                config.cpu_mode = mode;
+
+                long long refs = (long long)ref_count * process_count(jobmix);
+
+                Summary summary = measure(settings, [&]() {
+                    io::RandIntReader randintreader(io::make_random_source(config), false);
+                    pager::ShardedPager pager(config, randintreader, 4 * cpus, mode == io::CPU_DETERMINISTIC);
+                    driver::MultiCpuDriver driver(config, pager, randintreader);
+
+                    auto start = std::chrono::steady_clock::now();
+                    driver.execute();
+                    return refs / seconds_since(start);
+                });
+
+                Case c("pager-threads", std::string(mode == io::CPU_RELAXED ? "relaxed-" : "deterministic-") +
+                                            std::to_string(cpus) + "cpu");
+                c.algorithm = algorithm;
+                c.frames = frames;
+                c.processes = process_count(jobmix);
+                c.jobmix = jobmix;
+                c.operations = refs;
+                csv.write_row(c, "refs_per_sec", summary);
+            }
+        }
+    }
+}
+} // namespace bench
@@ -0,0 +1,30 @@
+#ifndef H_BENCH_PAGERBENCH
+#define H_BENCH_PAGERBENCH
+
+#include "harness.h"
+
+namespace bench
+{
+/**
+ * Cost of a single reference in each replacement algorithm: ns per hit over a
+ * stream that only touches resident pages, and ns per fault over a stream of
+ * pages never seen before (each one evicts), for frame counts from 10 up to
+ * settings.max_frames. The frame table is filled before the clock starts.
+ */
+void run_pager_micro(const Settings &settings, CsvWriter &csv);
+
+/**
+ * References per second of a complete simulation (reference generation and
+ * paging, as ./exec runs it) for every algorithm, frame count and job mix.
+ */
+void run_pager_macro(const Settings &settings, CsvWriter &csv);
+
+/**
+ * References per second of the multi-CPU driver over the sharded pager, in
+ * both CPU modes, for 1, 2, 4, ... CPUs up to the machine's hardware threads
+ * (at least 4, the processes of job mix 4).
+ */
+void run_pager_threads(const Settings &settings, CsvWriter &csv);
+} // namespace bench
+
+#endif
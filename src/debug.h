@@ -7,9 +7,6 @@
 namespace demandpaging
 {
 
-bool debug();
-bool showrand();
-
 struct Timer
 {
     std::chrono::time_point<std::chrono::high_resolution_clock> start, end;
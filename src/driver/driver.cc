@@ -1,58 +1,96 @@
 #include "driver.h"
-#include "../debug.h"
 #include "jobmix.h"
 #include "process.h"
 #include "jobmixspec.h"
-#include "../pager/pager.h"
+#include "../pager/refsink.h"
 #include "../io/uin.h"
 #include "../io/randintreader.h"
+#include "../io/tracelog.h"
 
 namespace driver
 {
-namespace dp = demandpaging;
-
-const int Driver::MAX_QUANTUM_ = 3;
-
-Driver::Driver(const io::UserInput &uin, pager::Pager &pager, io::RandIntReader &randintreader)
+Driver::Driver(const io::UserInput &uin, pager::ReferenceSink &pager, io::RandIntReader &randintreader)
     : PROC_SIZE_(uin.proc_size), JOB_MIX_DEF_(uin.jobmix),
-      REF_COUNT_(uin.ref_count), runtime_(1), randintreader_(randintreader), pager_(pager)
+      REF_COUNT_(uin.ref_count), DEBUG_(uin.debug), QUANTUM_(uin.quantum),
+      BATCHED_(!uin.showrand && uin.ref_count > 0 &&
+               (uin.rng != io::RNG_FILE || uin.algoname != pager::RANDOM)),
+      runtime_(1), randintreader_(randintreader), pager_(pager), batch_(uin.quantum)
 {
+    /**
+     * Batching draws a whole quantum's numbers before the pager sees its
+     * references, which keeps every sequence as it is unless the numbers
+     * are interleaved with something else: the show-random output, or the
+     * evictions of a random pager drawing from the same file stream as the
+     * processes. An empty process also draws a number, which a batch of
+     * zero references would not.
+     */
+
     /* Initialize job mix */
 
     JOB_MIX_ = driver::jobmixspecs::get_jobmix(JOB_MIX_DEF_);
 
-    if (dp::debug())
+    if (DEBUG_)
     {
+        io::trace_log().flush();
         JOB_MIX_->print();
     }
 
+    /* Initialize scheduler */
+
+    scheduler_reader_ = make_scheduler_reader(uin, randintreader_, 0);
+    scheduler_ = make_scheduler(uin, scheduler_reader_ ? *scheduler_reader_ : randintreader_);
+
     /* Initialize runnable processes */
 
     int num_of_processes = JOB_MIX_->process_count();
 
+    processes_.reserve(num_of_processes);
+
     for (int id = 1; id < (num_of_processes + 1); id++)
-        runnable_processes_.push_back(Process(id, PROC_SIZE_, REF_COUNT_));
+    {
+        processes_.push_back(Process(id, JOB_MIX_->process_size(id, PROC_SIZE_), JOB_MIX_->ref_count(id, REF_COUNT_)));
+        scheduler_->add(id - 1, JOB_MIX_->tickets(id));
+    }
+
+    /**
+     * Sources that can be split give every process its own substream, so a
+     * process' references do not depend on how the others are scheduled.
+     * The shared reader (stream 0) stays with the pager.
+     */
+
+    process_readers_.resize(num_of_processes + 1);
+
+    for (int id = 1; id < (num_of_processes + 1); id++)
+        process_readers_[id] = randintreader_.substream(id);
 }
 
 Driver::~Driver() {}
 
 void Driver::execute()
 {
+    if (BATCHED_)
+    {
+        execute_batched();
+        return;
+    }
+
     int quantum_ctr = 0;
 
     while (!is_all_process_terminated())
     {
-        if (quantum_ctr == MAX_QUANTUM_)
+        if (quantum_ctr == QUANTUM_)
         {
             context_switch(quantum_ctr);
         }
 
-        runnable_processes_.front().do_reference(pager_, runtime_);
-        runnable_processes_.front().set_next_ref_type(randintreader_, JOB_MIX_);
+        Process &process = processes_[scheduler_->current()];
+
+        process.do_reference(pager_, runtime_);
+        process.set_next_ref_type(reader_for(process), JOB_MIX_);
 
         quantum_ctr++;
 
-        if (runnable_processes_.front().should_terminate())
+        if (process.should_terminate())
         {
             remove_terminated_process(quantum_ctr);
         }
@@ -61,23 +99,62 @@ void Driver::execute()
     }
 }
 
+void Driver::execute_batched()
+{
+    int quantum_ctr = 0;
+
+    while (!is_all_process_terminated())
+    {
+        if (quantum_ctr == QUANTUM_)
+        {
+            context_switch(quantum_ctr);
+        }
+
+        Process &process = processes_[scheduler_->current()];
+
+        int count = process.generate_batch(&batch_[0], QUANTUM_ - quantum_ctr, reader_for(process), JOB_MIX_);
+        pager_.reference_batch(&batch_[0], count, process.id(), runtime_);
+
+        quantum_ctr += count;
+        runtime_ += count;
+
+        if (process.should_terminate())
+        {
+            remove_terminated_process(quantum_ctr);
+        }
+    }
+}
+
 void Driver::context_switch(int &qtm)
 {
-    Process front_process = runnable_processes_.front();
-    runnable_processes_.push_back(front_process);
-    runnable_processes_.pop_front();
+    int from_pid = processes_[scheduler_->current()].id();
+
+    scheduler_->preempt();
     qtm = 0;
+
+    pager_.context_switch(from_pid, processes_[scheduler_->current()].id());
 }
 
 void Driver::remove_terminated_process(int &qtm)
 {
-    runnable_processes_.pop_front();
+    int terminated_pid = processes_[scheduler_->current()].id();
+
+    scheduler_->remove_current();
     qtm = 0;
+
+    if (!scheduler_->empty())
+        pager_.context_switch(terminated_pid, processes_[scheduler_->current()].id());
+}
+
+io::RandIntReader &Driver::reader_for(const Process &process)
+{
+    io::RandIntReader *reader = process_readers_[process.id()].get();
+    return reader ? *reader : randintreader_;
 }
 
 bool Driver::is_all_process_terminated() const
 {
-    return runnable_processes_.size() == 0;
+    return scheduler_->empty();
 }
 
 } // namespace driver
\ No newline at end of file
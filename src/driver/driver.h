@@ -1,9 +1,11 @@
 #ifndef H_DRIVER
 #define H_DRIVER
 
-#include <deque>
+#include <memory>
+#include <vector>
 
 #include "process.h"
+#include "scheduler.h"
 
 namespace io
 {
@@ -13,7 +15,7 @@ struct UserInput;
 
 namespace pager
 {
-class Pager;
+class ReferenceSink;
 }
 
 namespace driver
@@ -22,27 +24,36 @@ class JobMix;
 class Driver
 {
 public:
-    Driver(const io::UserInput &uin, pager::Pager &pager, io::RandIntReader &randintreader);
+    Driver(const io::UserInput &uin, pager::ReferenceSink &pager, io::RandIntReader &randintreader);
     ~Driver();
     void execute();
 
 private:
+    void execute_batched();
     void context_switch(int &qtm);
     void remove_terminated_process(int &qtm);
     bool is_all_process_terminated() const;
+    io::RandIntReader &reader_for(const Process &process);
 
     const int PROC_SIZE_;
     const int JOB_MIX_DEF_;
     const int REF_COUNT_;
+    const bool DEBUG_;
+    const int QUANTUM_;
+    const bool BATCHED_; /* a quantum's references are generated, then handed to the pager, together */
 
-    static const int MAX_QUANTUM_;
     int runtime_;
 
     io::RandIntReader &randintreader_;
+    std::vector<std::unique_ptr<io::RandIntReader>> process_readers_;
     JobMix *JOB_MIX_;
-    pager::Pager &pager_;
+    pager::ReferenceSink &pager_;
 
-    std::deque<Process> runnable_processes_;
+    std::vector<Process> processes_; /* arena; process id is slot + 1 */
+    std::unique_ptr<io::RandIntReader> scheduler_reader_;
+    std::unique_ptr<Scheduler> scheduler_;
+
+    std::vector<int> batch_; /* virtual addresses of the current quantum */
 };
 
 } // namespace driver
@@ -3,11 +3,6 @@
 #include "jobmix.h"
 #include "../io/randintreader.h"
 #include "../memref/memref.h"
-#include "../memref/memref_back.h"
-#include "../memref/memref_init.h"
-#include "../memref/memref_jmp.h"
-#include "../memref/memref_rand.h"
-#include "../memref/memref_seq.h"
 
 namespace driver
 {
@@ -33,6 +28,22 @@ JobMix::JobMix(int id, int proc_count, bool is_uniform, std::vector<JobMixPerPro
         jobmix.jump_ref_threshold = calc_jmp_ref_threshold(jobmix.backward_ref_threshold,
                                                            jobmix.jump_ref_dist);
     }
+
+    thresholds_.resize(PROC_COUNT_);
+
+    for (int pid = 1; pid <= PROC_COUNT_; pid++)
+    {
+        const JobMixPerProcess &jobmix = spec_of(pid);
+
+        thresholds_[pid - 1].sequential = jobmix.sequential_ref_threshold;
+        thresholds_[pid - 1].backward = jobmix.backward_ref_threshold;
+        thresholds_[pid - 1].jump = jobmix.jump_ref_threshold;
+    }
+}
+
+const JobMixPerProcess &JobMix::spec_of(int pid) const
+{
+    return JOBMIXES_[IS_UNIFORM_ ? 0 : (pid - 1)];
 }
 
 int JobMix::process_count() const
@@ -40,27 +51,44 @@ int JobMix::process_count() const
     return PROC_COUNT_;
 }
 
-std::shared_ptr<memref::Reference> JobMix::next_ref_type(double quotient, int pid, io::RandIntReader &randintreader) const
+int JobMix::process_size(int pid, int default_size) const
 {
-    int access_idx = IS_UNIFORM_ ? 0 : (pid - 1);
+    int size = spec_of(pid).process_size;
+    return size > 0 ? size : default_size;
+}
 
-    if (0.0 <= quotient && quotient <= JOBMIXES_[access_idx].sequential_ref_threshold)
-    {
-        return std::unique_ptr<memref::Reference>{new memref::SequentialReference(pid)};
-    }
-    else if (quotient <= JOBMIXES_[access_idx].backward_ref_threshold)
-    {
-        return std::unique_ptr<memref::Reference>{new memref::BackwardReference(pid)};
+int JobMix::ref_count(int pid, int default_count) const
+{
+    int count = spec_of(pid).ref_count;
+    return count > 0 ? count : default_count;
+}
 
-    }
-    else if (quotient <= JOBMIXES_[access_idx].jump_ref_threshold)
-    {
-        return std::unique_ptr<memref::Reference>{new memref::JumpReference(pid)};
-    }
-    else
+int JobMix::tickets(int pid) const
+{
+    int tickets = spec_of(pid).tickets;
+    return tickets > 0 ? tickets : 1;
+}
+
+memref::Reference JobMix::next_ref_type(double quotient, int pid, io::RandIntReader &randintreader) const
+{
+    /**
+     * The thresholds are non-decreasing, so the number of them below the
+     * quotient is the kind of reference: sequential, backward, jump, random.
+     */
+
+    const Thresholds &row = thresholds_[pid - 1];
+    int kind = (quotient > row.sequential) + (quotient > row.backward) + (quotient > row.jump);
+
+    switch (kind)
     {
-        int randnum = randintreader.read_next_int();
-        return std::unique_ptr<memref::Reference>{new memref::RandomReference(pid, randnum)};
+    case 0:
+        return memref::Reference::sequential();
+    case 1:
+        return memref::Reference::backward();
+    case 2:
+        return memref::Reference::jump();
+    default:
+        return memref::Reference::random(randintreader.read_next_int());
     }
 }
 
@@ -77,8 +105,18 @@ void JobMix::print() const
                   << "\tthreshold: " << jobmix.backward_ref_threshold << "\n"
                   << "JobMix jump ref dist (C): " << jobmix.jump_ref_dist
                   << "\tthreshold: " << jobmix.jump_ref_threshold << "\n"
-                  << "JobMix rand ref dist (D): " << jobmix.rand_ref_dist << "\n"
-                  << std::endl;
+                  << "JobMix rand ref dist (D): " << jobmix.rand_ref_dist << "\n";
+
+        if (jobmix.process_size > 0)
+            std::cout << "Process size: " << jobmix.process_size << "\n";
+
+        if (jobmix.ref_count > 0)
+            std::cout << "Reference count: " << jobmix.ref_count << "\n";
+
+        if (jobmix.tickets > 0)
+            std::cout << "Tickets: " << jobmix.tickets << "\n";
+
+        std::cout << std::endl;
     }
 }
 } // namespace driver
\ No newline at end of file
@@ -1,10 +1,6 @@
 #include <vector>
-#include <memory>
 
-namespace memref
-{
-class Reference;
-}
+#include "../memref/memref.h"
 
 namespace io
 {
@@ -23,6 +19,10 @@ struct JobMixPerProcess
     double sequential_ref_threshold; /* A */
     double backward_ref_threshold;   /* A + B */
     double jump_ref_threshold;       /* A + B + C */
+
+    int process_size; /* 0 for the process size of the command line */
+    int ref_count;    /* 0 for the reference count of the command line */
+    int tickets;      /* lottery scheduling tickets; 0 for one */
 };
 
 class JobMix
@@ -31,18 +31,39 @@ public:
     JobMix(int id, int proc_count, bool is_uniform, std::vector<JobMixPerProcess> jobmixes);
     JobMix();
 
-    std::shared_ptr<memref::Reference> next_ref_type(double quotient,
-                                                     int pid,
-                                                     io::RandIntReader &randintreader) const;
+    memref::Reference next_ref_type(double quotient,
+                                    int pid,
+                                    io::RandIntReader &randintreader) const;
 
     int process_count() const;
+
+    /* Size and reference count of process pid, or the given defaults if its spec leaves them out */
+    int process_size(int pid, int default_size) const;
+    int ref_count(int pid, int default_count) const;
+    int tickets(int pid) const;
+
     void print() const;
 
 private:
+    /**
+     * The cumulative thresholds of each process, one row per pid, so that
+     * next_ref_type classifies a quotient with three comparisons and no
+     * search, whether the mix is uniform or not.
+     */
+    struct Thresholds
+    {
+        double sequential;
+        double backward;
+        double jump;
+    };
+
+    const JobMixPerProcess &spec_of(int pid) const;
+
     const int ID_;
     const int PROC_COUNT_;
     const bool IS_UNIFORM_;
 
     std::vector<JobMixPerProcess> JOBMIXES_;
+    std::vector<Thresholds> thresholds_; /* thresholds_[pid - 1] */
 };
 } // namespace driver
\ No newline at end of file
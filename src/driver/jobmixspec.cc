@@ -1,6 +1,14 @@
 #include "jobmix.h"
 #include "jobmixspec.h"
 
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
 namespace driver
 {
 namespace jobmixspecs
@@ -19,8 +27,166 @@ JobMix jobmix_4 = JobMix(4, 4, DIFF_JOBMIX_PER_PROCESS, {
                                                             JobMixPerProcess{0.5, 0.125, 0.125},
                                                         });
 
+namespace
+{
+std::map<int, std::unique_ptr<JobMix>> loaded_jobmixes;
+
+void fail(const std::string &path, int line_number, const std::string &message)
+{
+    std::cout << "Job mix file " << path << ", line " << line_number << ": " << message
+              << ". Terminating..." << std::endl;
+    exit(10);
+}
+
+void add_jobmix(int id, const std::vector<JobMixPerProcess> &processes, const std::string &path, int line_number)
+{
+    if (processes.empty())
+        fail(path, line_number, "job mix " + std::to_string(id) + " has no processes");
+
+    loaded_jobmixes[id].reset(new JobMix(id, (int)processes.size(), DIFF_JOBMIX_PER_PROCESS, processes));
+}
+
+/* std::stoi and std::stod, but the whole token must be the number */
+int parse_int(const std::string &token)
+{
+    size_t pos = 0;
+    int value = std::stoi(token, &pos);
+
+    if (pos != token.size())
+        throw std::invalid_argument(token);
+
+    return value;
+}
+
+double parse_double(const std::string &token)
+{
+    size_t pos = 0;
+    double value = std::stod(token, &pos);
+
+    if (pos != token.size())
+        throw std::invalid_argument(token);
+
+    return value;
+}
+
+/* `[K x] A B C [SIZE [REFS [TICKETS]]]`; false if the line does not have that form */
+bool parse_process_line(const std::string &line, int &repeat, JobMixPerProcess &spec)
+{
+    std::vector<std::string> tokens;
+    std::istringstream iss(line);
+    std::string token;
+
+    while (iss >> token)
+        tokens.push_back(token);
+
+    size_t first = 0;
+    repeat = 1;
+
+    if (tokens.size() >= 2 && tokens[1] == "x")
+    {
+        repeat = parse_int(tokens[0]);
+        first = 2;
+    }
+
+    size_t count = tokens.size() - first;
+
+    if (count < 3 || count > 6 || repeat < 1)
+        return false;
+
+    spec = JobMixPerProcess();
+    spec.sequential_ref_dist = parse_double(tokens[first]);
+    spec.backward_ref_dist = parse_double(tokens[first + 1]);
+    spec.jump_ref_dist = parse_double(tokens[first + 2]);
+    spec.process_size = (count >= 4) ? parse_int(tokens[first + 3]) : 0;
+    spec.ref_count = (count >= 5) ? parse_int(tokens[first + 4]) : 0;
+    spec.tickets = (count >= 6) ? parse_int(tokens[first + 5]) : 0;
+
+    return spec.sequential_ref_dist >= 0 && spec.backward_ref_dist >= 0 && spec.jump_ref_dist >= 0 &&
+           spec.sequential_ref_dist + spec.backward_ref_dist + spec.jump_ref_dist <= 1 + 1e-9 &&
+           spec.process_size >= 0 && spec.ref_count >= 0 && spec.tickets >= 0;
+}
+} // namespace
+
+void load_jobmix_file(const std::string &path)
+{
+    std::ifstream infile(path);
+
+    if (!infile)
+    {
+        std::cout << "An error occured opening the job mix file " << path << ". Terminating..." << std::endl;
+        exit(10);
+    }
+
+    std::vector<JobMixPerProcess> processes;
+    std::vector<int> defined;
+    int id = -1;
+    int id_line = 0;
+    int line_number = 0;
+    std::string line;
+
+    while (std::getline(infile, line))
+    {
+        line_number++;
+        line = line.substr(0, line.find('#'));
+
+        std::istringstream iss(line);
+        std::string keyword;
+
+        if (!(iss >> keyword))
+            continue;
+
+        if (keyword == "jobmix")
+        {
+            if (id >= 0)
+                add_jobmix(id, processes, path, id_line);
+
+            std::string rest;
+
+            if (!(iss >> id) || id < 1 || (iss >> rest))
+                fail(path, line_number, "expected `jobmix ID` with a positive ID");
+
+            for (int seen : defined)
+                if (seen == id)
+                    fail(path, line_number, "job mix " + std::to_string(id) + " is defined twice");
+
+            defined.push_back(id);
+            processes.clear();
+            id_line = line_number;
+            continue;
+        }
+
+        if (id < 0)
+            fail(path, line_number, "processes must follow a `jobmix ID` line");
+
+        int repeat = 1;
+        JobMixPerProcess spec;
+        bool is_valid = false;
+
+        try
+        {
+            is_valid = parse_process_line(line, repeat, spec);
+        }
+        catch (const std::exception &e)
+        {
+        }
+
+        if (!is_valid)
+            fail(path, line_number, "expected `[K x] A B C [SIZE [REFS [TICKETS]]]` with A + B + C at most 1");
+
+        processes.insert(processes.end(), repeat, spec);
+    }
+
+    if (id >= 0)
+        add_jobmix(id, processes, path, id_line);
+}
+
 JobMix *get_jobmix(int id)
 {
+    auto loaded = loaded_jobmixes.find(id);
+
+    if (loaded != loaded_jobmixes.end())
+        return loaded->second.get();
+
     switch (id)
     {
     case 1:
@@ -1,3 +1,8 @@
+#ifndef H_JOBMIXSPEC
+#define H_JOBMIXSPEC
+
+#include <string>
+
 namespace driver
 {
 class JobMix;
@@ -5,7 +10,26 @@ class JobMix;
 namespace jobmixspecs
 {
 
+/* Job mix id: one loaded from a file if any, else built-in mixes 1 to 4; nullptr if neither */
 extern JobMix *get_jobmix(int id);
 
+/**
+ * Loads the job mixes defined in a text file, which take precedence over the
+ * built-in ones. Each mix starts with a `jobmix ID` line, followed by one line
+ * per process:
+ *
+ *      [K x] A B C [SIZE [REFS [TICKETS]]]
+ *
+ * A, B and C are the probabilities of sequential, backward and jump
+ * references (the rest are random); SIZE and REFS override the process size
+ * and reference count of the command line (0 keeps them); TICKETS weighs
+ * the process under lottery scheduling (default 1); the optional
+ * `K x` repeats the line for K processes. `#` starts a comment. Exits on a
+ * malformed file.
+ */
+void load_jobmix_file(const std::string &path);
+
 } // namespace jobmixspecs
-} // namespace driver
\ No newline at end of file
+} // namespace driver
+
+#endif
@@ -0,0 +1,205 @@
+#include "multicpudriver.h"
+#include "jobmix.h"
+#include "jobmixspec.h"
+#include "../pager/refsink.h"
+#include "../io/randintreader.h"
+#include "../io/randsource.h"
+
+#include <thread>
+
+namespace driver
+{
+namespace
+{
+/* Stream ids of the relaxed CPUs' readers, clear of the per-process, lock-step, shard and scheduler ids */
+const uint64_t CPU_STREAM_BASE_ = 4ULL << 32;
+} // namespace
+
+MultiCpuDriver::MultiCpuDriver(const io::UserInput &uin, pager::ReferenceSink &pager,
+                               io::RandIntReader &randintreader)
+    : PROC_SIZE_(uin.proc_size), JOB_MIX_DEF_(uin.jobmix), REF_COUNT_(uin.ref_count), MODE_(uin.cpu_mode),
+      QUANTUM_(uin.quantum), randintreader_(randintreader), pager_(pager), cpus_(uin.cpus), turn_(-1), active_(uin.cpus, 0),
+      runtime_(1)
+{
+    JOB_MIX_ = driver::jobmixspecs::get_jobmix(JOB_MIX_DEF_);
+
+    /* Every CPU schedules an arena of its own, so CPUs never write to each other's processes */
+
+    for (size_t i = 0; i < cpus_.size(); i++)
+    {
+        cpus_[i].scheduler_reader = make_scheduler_reader(uin, randintreader_, (int)i);
+        cpus_[i].scheduler = make_scheduler(uin, cpus_[i].scheduler_reader ? *cpus_[i].scheduler_reader
+                                                                             : randintreader_);
+    }
+
+    int num_of_processes = JOB_MIX_->process_count();
+
+    for (int id = 1; id < (num_of_processes + 1); id++)
+    {
+        Cpu &cpu = cpus_[(id - 1) % cpus_.size()];
+
+        cpu.scheduler->add((int)cpu.processes.size(), JOB_MIX_->tickets(id));
+        cpu.processes.push_back(
+            Process(id, JOB_MIX_->process_size(id, PROC_SIZE_), JOB_MIX_->ref_count(id, REF_COUNT_)));
+    }
+
+    /**
+     * As in Driver, processes draw from substreams of their own when the
+     * source can be split. Otherwise they share the driver's reader, which
+     * the turns serialize; relaxed CPUs cannot share it, so each one reads
+     * the random number file from an offset of its own.
+     */
+
+    process_readers_.resize(num_of_processes + 1);
+
+    for (int id = 1; id < (num_of_processes + 1); id++)
+        process_readers_[id] = randintreader_.substream(id);
+
+    bool splittable = num_of_processes == 0 || process_readers_[1];
+
+    for (size_t i = 0; i < cpus_.size(); i++)
+    {
+        cpus_[i].quantum = 0;
+        cpus_[i].local_time = 0;
+
+        if (MODE_ == io::CPU_RELAXED && !splittable)
+            cpus_[i].reader.reset(new io::RandIntReader(io::make_random_source(uin, CPU_STREAM_BASE_ + i), false));
+
+        active_[i] = !cpus_[i].scheduler->empty();
+
+        if (active_[i] && turn_ < 0)
+            turn_ = (int)i;
+    }
+}
+
+MultiCpuDriver::~MultiCpuDriver() {}
+
+void MultiCpuDriver::execute()
+{
+    std::vector<std::thread> threads;
+
+    for (size_t i = 0; i < cpus_.size(); i++)
+    {
+        if (MODE_ == io::CPU_DETERMINISTIC)
+            threads.push_back(std::thread(&MultiCpuDriver::run_deterministic, this, (int)i));
+        else
+            threads.push_back(std::thread(&MultiCpuDriver::run_relaxed, this, (int)i));
+    }
+
+    for (auto &thread : threads)
+        thread.join();
+}
+
+int MultiCpuDriver::cpu_count() const
+{
+    return (int)cpus_.size();
+}
+
+int64_t MultiCpuDriver::reference_count() const
+{
+    int64_t count = 0;
+
+    for (auto &cpu : cpus_)
+        count += cpu.local_time;
+
+    return count;
+}
+
+void MultiCpuDriver::run_deterministic(int cpu_id)
+{
+    Cpu &cpu = cpus_[cpu_id];
+
+    while (!cpu.scheduler->empty())
+    {
+        while (turn_.load(std::memory_order_acquire) != cpu_id)
+            std::this_thread::yield();
+
+        step(cpu, runtime_++);
+
+        if (cpu.scheduler->empty())
+            active_[cpu_id] = 0;
+
+        pass_turn(cpu_id);
+    }
+}
+
+void MultiCpuDriver::pass_turn(int cpu_id)
+{
+    int count = (int)cpus_.size();
+
+    for (int i = 1; i <= count; i++)
+    {
+        int next = (cpu_id + i) % count;
+
+        if (active_[next])
+        {
+            turn_.store(next, std::memory_order_release);
+            return;
+        }
+    }
+
+    turn_.store(-1, std::memory_order_release);
+}
+
+void MultiCpuDriver::run_relaxed(int cpu_id)
+{
+    Cpu &cpu = cpus_[cpu_id];
+    int64_t count = (int64_t)cpus_.size();
+
+    while (!cpu.scheduler->empty())
+        step(cpu, (int)(cpu.local_time * count + cpu_id + 1));
+}
+
+void MultiCpuDriver::step(Cpu &cpu, int time_accessed)
+{
+    if (cpu.quantum == QUANTUM_)
+    {
+        context_switch(cpu);
+    }
+
+    Process &process = cpu.processes[cpu.scheduler->current()];
+
+    process.do_reference(pager_, time_accessed);
+    process.set_next_ref_type(reader_for(cpu, process), JOB_MIX_);
+
+    cpu.local_time++;
+    cpu.quantum++;
+
+    if (process.should_terminate())
+    {
+        remove_terminated_process(cpu);
+    }
+}
+
+void MultiCpuDriver::context_switch(Cpu &cpu)
+{
+    int from_pid = cpu.processes[cpu.scheduler->current()].id();
+
+    cpu.scheduler->preempt();
+    cpu.quantum = 0;
+
+    pager_.context_switch(from_pid, cpu.processes[cpu.scheduler->current()].id());
+}
+
+void MultiCpuDriver::remove_terminated_process(Cpu &cpu)
+{
+    int terminated_pid = cpu.processes[cpu.scheduler->current()].id();
+
+    cpu.scheduler->remove_current();
+    cpu.quantum = 0;
+
+    if (!cpu.scheduler->empty())
+        pager_.context_switch(terminated_pid, cpu.processes[cpu.scheduler->current()].id());
+}
+
+io::RandIntReader &MultiCpuDriver::reader_for(Cpu &cpu, const Process &process)
+{
+    io::RandIntReader *reader = process_readers_[process.id()].get();
+
+    if (reader)
+        return *reader;
+
+    return cpu.reader ? *cpu.reader : randintreader_;
+}
+
+} // namespace driver
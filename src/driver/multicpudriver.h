@@ -0,0 +1,91 @@
+#ifndef H_MULTICPUDRIVER
+#define H_MULTICPUDRIVER
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "process.h"
+#include "scheduler.h"
+#include "../io/uin.h"
+
+namespace pager
+{
+class ReferenceSink;
+}
+
+namespace driver
+{
+class JobMix;
+
+/**
+ * Driver for uin.cpus simulated CPUs, each running on a thread of its own
+ * with a run queue and scheduler like Driver's. Process i is placed on CPU
+ * (i - 1) % cpus for its whole life. The pager is referenced from every
+ * thread at once, so it must be thread-safe (see pager::ShardedPager).
+ *
+ * In CPU_DETERMINISTIC mode the CPUs issue one reference each in turn on a
+ * shared logical clock, which also stamps the references: runs are
+ * reproducible, and one CPU gives the same stream as Driver. In CPU_RELAXED
+ * mode the CPUs run without coordination and stamp references with clocks
+ * of their own, interleaved so that stamps stay unique; these clocks drift
+ * apart, so a pager referenced concurrently must keep its stamps in order
+ * itself (as pager::ShardedPager does).
+ */
+class MultiCpuDriver
+{
+public:
+    MultiCpuDriver(const io::UserInput &uin, pager::ReferenceSink &pager, io::RandIntReader &randintreader);
+    ~MultiCpuDriver();
+    void execute();
+
+    int cpu_count() const;
+    int64_t reference_count() const;
+
+private:
+    struct Cpu
+    {
+        std::vector<Process> processes; /* arena of the processes placed on this CPU */
+        std::unique_ptr<io::RandIntReader> scheduler_reader;
+        std::unique_ptr<Scheduler> scheduler;
+        int quantum;
+        int64_t local_time; /* references issued so far */
+
+        /* Numbers of the processes that cannot draw from substreams of their own; may be nullptr */
+        std::unique_ptr<io::RandIntReader> reader;
+
+        char padding[64]; /* keeps the counters of neighbouring CPUs off each other's cache lines */
+    };
+
+    void run_deterministic(int cpu_id);
+    void run_relaxed(int cpu_id);
+    void step(Cpu &cpu, int time_accessed);
+    void pass_turn(int cpu_id);
+
+    void context_switch(Cpu &cpu);
+    void remove_terminated_process(Cpu &cpu);
+    io::RandIntReader &reader_for(Cpu &cpu, const Process &process);
+
+    const int PROC_SIZE_;
+    const int JOB_MIX_DEF_;
+    const int REF_COUNT_;
+    const io::CpuMode MODE_;
+    const int QUANTUM_;
+
+    io::RandIntReader &randintreader_;
+    std::vector<std::unique_ptr<io::RandIntReader>> process_readers_;
+    JobMix *JOB_MIX_;
+    pager::ReferenceSink &pager_;
+
+    std::vector<Cpu> cpus_;
+
+    /* CPU_DETERMINISTIC: the CPU whose turn it is (-1 once all are idle) and the logical clock */
+    std::atomic<int> turn_;
+    std::vector<char> active_; /* changed only by the CPU holding the turn */
+    int runtime_;
+};
+
+} // namespace driver
+
+#endif
@@ -1,12 +1,8 @@
 #include "process.h"
 
-#include <memory>
-
 #include "jobmix.h"
-#include "../pager/pager.h"
+#include "../pager/refsink.h"
 #include "../memref/memref.h"
-#include "../memref/memref_init.h"
-#include "../memref/memref_rand.h"
 #include "../io/randintreader.h"
 
 namespace driver
@@ -16,17 +12,17 @@ const int Process::REF_ADDR_UNDEF_ = -1;
 Process::Process(int id, int proc_size, int ref_count)
     : ID_(id), SIZE_(proc_size), TOTAL_REF_COUNT_(ref_count),
       prior_ref_addr_(REF_ADDR_UNDEF_),
-      remaining_ref_count_(ref_count)
-{
-    nextref_ = std::unique_ptr<memref::Reference>{new memref::InitialReference(ID_)};
-}
+      nextref_(memref::Reference::initial()),
+      remaining_ref_count_(ref_count) {}
 
-void Process::do_reference(pager::Pager &pager, int access_time)
+void Process::do_reference(pager::ReferenceSink &pager, int access_time)
 {
     if (remaining_ref_count_ == 0)
         return;
 
-    prior_ref_addr_ = nextref_->simulate(prior_ref_addr_, SIZE_, pager, access_time);
+    prior_ref_addr_ = nextref_.next_addr(prior_ref_addr_, SIZE_, ID_);
+
+    pager.reference_by_virtual_addr(prior_ref_addr_, ID_, access_time);
 
     remaining_ref_count_--;
 }
@@ -37,6 +33,25 @@ void Process::set_next_ref_type(io::RandIntReader &randintreader, driver::JobMix
     nextref_ = jobmix->next_ref_type(quotient, ID_, randintreader);
 }
 
+int Process::generate_batch(int *viraddrs, int count, io::RandIntReader &randintreader, driver::JobMix *jobmix)
+{
+    if (count > remaining_ref_count_)
+        count = remaining_ref_count_;
+
+    for (int i = 0; i < count; i++)
+    {
+        prior_ref_addr_ = nextref_.next_addr(prior_ref_addr_, SIZE_, ID_);
+        viraddrs[i] = prior_ref_addr_;
+
+        double quotient = randintreader.calc_next_probability();
+        nextref_ = jobmix->next_ref_type(quotient, ID_, randintreader);
+    }
+
+    remaining_ref_count_ -= count;
+
+    return count;
+}
+
 bool Process::should_terminate() const
 {
     return remaining_ref_count_ == 0;
@@ -2,13 +2,12 @@
 #define H_PROCESS
 
 #include <iostream>
-#include <memory>
 
 #include "../memref/memref.h"
 
 namespace pager
 {
-class Pager;
+class ReferenceSink;
 }
 
 namespace io
@@ -27,9 +26,17 @@ class Process
 {
 public:
     Process(int id, int proc_size, int ref_count);
-    void do_reference(pager::Pager &pager, int access_time);
+    void do_reference(pager::ReferenceSink &pager, int access_time);
     void set_next_ref_type(io::RandIntReader &randintreader, driver::JobMix *jobmix);
 
+    /**
+     * Up to count next references into viraddrs, each followed by the draw of
+     * the next reference type, exactly as count do_reference and
+     * set_next_ref_type pairs would; stops early when the process runs out of
+     * references. Returns the number generated.
+     */
+    int generate_batch(int *viraddrs, int count, io::RandIntReader &randintreader, driver::JobMix *jobmix);
+
     bool should_terminate() const;
     int id() const;
 
@@ -43,7 +50,7 @@ private:
     static const int REF_ADDR_UNDEF_; /* Current reference address undefined (uninitialized) */
 
     int prior_ref_addr_;
-    std::shared_ptr<memref::Reference> nextref_;
+    memref::Reference nextref_;
     int remaining_ref_count_;
 };
 } // namespace driver
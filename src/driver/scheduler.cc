@@ -0,0 +1,220 @@
+#include "scheduler.h"
+#include "../io/randintreader.h"
+#include "../io/randsource.h"
+
+namespace driver
+{
+namespace
+{
+/* Substream ids of the schedulers' streams, clear of the per-process, lock-step and shard ids */
+const uint64_t SCHEDULER_STREAM_BASE_ = 3ULL << 32;
+} // namespace
+
+RoundRobinScheduler::RoundRobinScheduler() : current_(-1) {}
+
+void RoundRobinScheduler::add(int slot, int tickets)
+{
+    if ((int)next_.size() <= slot)
+    {
+        next_.resize(slot + 1, -1);
+        prev_.resize(slot + 1, -1);
+    }
+
+    if (current_ < 0)
+    {
+        next_[slot] = slot;
+        prev_[slot] = slot;
+        current_ = slot;
+        return;
+    }
+
+    /* Joins at the back of the queue, just before the running process */
+
+    int last = prev_[current_];
+
+    next_[last] = slot;
+    prev_[slot] = last;
+    next_[slot] = current_;
+    prev_[current_] = slot;
+}
+
+bool RoundRobinScheduler::empty() const
+{
+    return current_ < 0;
+}
+
+int RoundRobinScheduler::current() const
+{
+    return current_;
+}
+
+void RoundRobinScheduler::preempt()
+{
+    current_ = next_[current_];
+}
+
+void RoundRobinScheduler::remove_current()
+{
+    int slot = current_;
+
+    if (next_[slot] == slot)
+    {
+        current_ = -1;
+        return;
+    }
+
+    next_[prev_[slot]] = next_[slot];
+    prev_[next_[slot]] = prev_[slot];
+    current_ = next_[slot];
+}
+
+RandomScheduler::RandomScheduler(io::RandIntReader &randintreader)
+    : randintreader_(randintreader), current_(0) {}
+
+void RandomScheduler::add(int slot, int tickets)
+{
+    runnable_.push_back(slot);
+}
+
+bool RandomScheduler::empty() const
+{
+    return runnable_.empty();
+}
+
+int RandomScheduler::current() const
+{
+    return runnable_[current_];
+}
+
+void RandomScheduler::preempt()
+{
+    current_ = randintreader_.read_next_int() % (int)runnable_.size();
+}
+
+void RandomScheduler::remove_current()
+{
+    runnable_[current_] = runnable_.back();
+    runnable_.pop_back();
+
+    if (!runnable_.empty())
+        preempt();
+}
+
+LotteryScheduler::LotteryScheduler(io::RandIntReader &randintreader)
+    : randintreader_(randintreader), tree_(1, 0), total_(0), runnable_count_(0), current_(-1) {}
+
+void LotteryScheduler::add(int slot, int tickets)
+{
+    if (tickets < 1)
+        tickets = 1;
+
+    if ((int)tickets_.size() <= slot)
+    {
+        /* Rebuilt over the larger range; slots are added once, so this is amortized O(1) */
+
+        tickets_.resize(2 * slot + 2, 0);
+        tree_.assign(tickets_.size() + 1, 0);
+        total_ = 0;
+
+        for (size_t i = 0; i < tickets_.size(); i++)
+        {
+            if (tickets_[i] > 0)
+            {
+                int64_t held = tickets_[i];
+                tickets_[i] = 0;
+                add_tickets((int)i, held);
+            }
+        }
+    }
+
+    add_tickets(slot, tickets);
+    runnable_count_++;
+
+    if (current_ < 0)
+        current_ = slot;
+}
+
+void LotteryScheduler::add_tickets(int slot, int64_t delta)
+{
+    tickets_[slot] += delta;
+    total_ += delta;
+
+    for (size_t pos = slot + 1; pos < tree_.size(); pos += pos & (~pos + 1))
+        tree_[pos] += delta;
+}
+
+int LotteryScheduler::find_ticket(int64_t ticket) const
+{
+    /* Descends the tree to the slot whose range of tickets holds ticket */
+
+    size_t pos = 0;
+    size_t step = 1;
+
+    while (step * 2 < tree_.size())
+        step *= 2;
+
+    for (; step > 0; step /= 2)
+    {
+        if (pos + step < tree_.size() && tree_[pos + step] <= ticket)
+        {
+            pos += step;
+            ticket -= tree_[pos];
+        }
+    }
+
+    return (int)pos;
+}
+
+bool LotteryScheduler::empty() const
+{
+    return runnable_count_ == 0;
+}
+
+int LotteryScheduler::current() const
+{
+    return current_;
+}
+
+void LotteryScheduler::preempt()
+{
+    current_ = find_ticket(randintreader_.read_next_int() % total_);
+}
+
+void LotteryScheduler::remove_current()
+{
+    add_tickets(current_, -tickets_[current_]);
+    runnable_count_--;
+
+    if (runnable_count_ > 0)
+        preempt();
+}
+
+std::unique_ptr<Scheduler> make_scheduler(const io::UserInput &uin, io::RandIntReader &randintreader)
+{
+    switch (uin.sched)
+    {
+    case io::SCHEDULE_RANDOM:
+        return std::unique_ptr<Scheduler>(new RandomScheduler(randintreader));
+    case io::SCHEDULE_LOTTERY:
+        return std::unique_ptr<Scheduler>(new LotteryScheduler(randintreader));
+    default:
+        return std::unique_ptr<Scheduler>(new RoundRobinScheduler());
+    }
+}
+
+std::unique_ptr<io::RandIntReader> make_scheduler_reader(const io::UserInput &uin, const io::RandIntReader &shared,
+                                                         int queue_id)
+{
+    if (uin.sched == io::SCHEDULE_ROUND_ROBIN)
+        return nullptr;
+
+    std::unique_ptr<io::RandIntReader> reader = shared.substream(SCHEDULER_STREAM_BASE_ + queue_id);
+
+    /* The random number file cannot be split: read it from an offset of the queue's own */
+    if (!reader)
+        reader.reset(new io::RandIntReader(io::make_random_source(uin, SCHEDULER_STREAM_BASE_ + queue_id), false));
+
+    return reader;
+}
+
+} // namespace driver
@@ -0,0 +1,122 @@
+#ifndef H_SCHEDULER
+#define H_SCHEDULER
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "../io/uin.h"
+
+namespace io
+{
+class RandIntReader;
+}
+
+namespace driver
+{
+/**
+ * Scheduling discipline over the runnable processes of one run queue. The
+ * processes live in an arena owned by the driver and are named by their
+ * slot in it; a scheduler only orders slots, so rotating or removing a
+ * process never copies it. Every operation is O(1), except the lottery's
+ * O(log n).
+ */
+class Scheduler
+{
+public:
+    virtual ~Scheduler() {}
+
+    /* Makes slot runnable; the first slot added runs first. */
+    virtual void add(int slot, int tickets) = 0;
+
+    virtual bool empty() const = 0;
+
+    /* Slot of the running process; only while not empty. */
+    virtual int current() const = 0;
+
+    /* The running process used up its quantum: pick the next one, possibly the same. */
+    virtual void preempt() = 0;
+
+    /* The running process terminated: drop it and pick the next one, if any. */
+    virtual void remove_current() = 0;
+};
+
+/* Runs the processes in the order they were added, each for a quantum in turn. */
+class RoundRobinScheduler : public Scheduler
+{
+public:
+    RoundRobinScheduler();
+
+    void add(int slot, int tickets) override;
+    bool empty() const override;
+    int current() const override;
+    void preempt() override;
+    void remove_current() override;
+
+private:
+    /* Circular doubly linked list threaded through the slots */
+    std::vector<int> next_;
+    std::vector<int> prev_;
+    int current_;
+};
+
+/* Picks the next process uniformly at random, from a stream of its own. */
+class RandomScheduler : public Scheduler
+{
+public:
+    RandomScheduler(io::RandIntReader &randintreader);
+
+    void add(int slot, int tickets) override;
+    bool empty() const override;
+    int current() const override;
+    void preempt() override;
+    void remove_current() override;
+
+private:
+    io::RandIntReader &randintreader_;
+
+    std::vector<int> runnable_; /* dense; removal swaps with the last */
+    int current_;               /* index into runnable_ */
+};
+
+/* Picks the next process with probability proportional to its tickets. */
+class LotteryScheduler : public Scheduler
+{
+public:
+    LotteryScheduler(io::RandIntReader &randintreader);
+
+    void add(int slot, int tickets) override;
+    bool empty() const override;
+    int current() const override;
+    void preempt() override;
+    void remove_current() override;
+
+private:
+    void add_tickets(int slot, int64_t delta);
+    int find_ticket(int64_t ticket) const;
+
+    io::RandIntReader &randintreader_;
+
+    std::vector<int64_t> tickets_; /* tickets_[slot], 0 once it terminated */
+    std::vector<int64_t> tree_;    /* Fenwick tree of tickets_ over slots 1..n */
+    int64_t total_;
+    int runnable_count_;
+    int current_;
+};
+
+/* The scheduler of uin.sched; randintreader must outlive it. */
+std::unique_ptr<Scheduler> make_scheduler(const io::UserInput &uin, io::RandIntReader &randintreader);
+
+/**
+ * Stream of the random scheduler of run queue queue_id, kept apart so that
+ * the choice of discipline does not shift the numbers the processes see: a
+ * substream of shared, or the random number file read from an offset of
+ * the queue's own.
+ * nullptr for round robin, which draws nothing.
+ */
+std::unique_ptr<io::RandIntReader> make_scheduler_reader(const io::UserInput &uin, const io::RandIntReader &shared,
+                                                         int queue_id);
+
+} // namespace driver
+
+#endif
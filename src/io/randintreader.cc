@@ -1,30 +1,14 @@
-#include <fstream>
-#include <iostream>
-
 #include "randintreader.h"
-#include "../debug.h"
+#include "tracelog.h"
 
 namespace io
 {
 const int RandIntReader::MAX_INT_ = 2147483647;
 
-namespace dp = demandpaging;
-
-RandIntReader::RandIntReader()
-{
-    infile_.open("src/io/random-numbers.txt");
-
-    if (!infile_)
-    {
-        std::cout << "ERROR: Could not open rand-num file." << std::endl;
-        exit(10);
-    }
-}
+RandIntReader::RandIntReader(std::unique_ptr<RandomSource> source, bool showrand)
+    : source_(std::move(source)), SHOW_RAND_(showrand) {}
 
-RandIntReader::~RandIntReader()
-{
-    infile_.close();
-}
+RandIntReader::~RandIntReader() {}
 
 double RandIntReader::calc_next_probability()
 {
@@ -35,12 +19,25 @@ double RandIntReader::calc_next_probability()
 
 int RandIntReader::read_next_int()
 {
-    int nextint;
-    infile_ >> nextint;
-    
-    if (dp::showrand())
-        std::cout << "uses random number " << nextint << std::endl;
+    int nextint = source_->next();
+
+    if (SHOW_RAND_)
+        trace_log() << "uses random number " << nextint << '\n';
 
     return nextint;
 }
-} // namespace io
\ No newline at end of file
+
+uint64_t RandIntReader::position() const { return source_->position(); }
+
+void RandIntReader::seek(uint64_t position) { source_->seek(position); }
+
+std::unique_ptr<RandIntReader> RandIntReader::substream(uint64_t stream_id) const
+{
+    std::unique_ptr<RandomSource> sub = source_->substream(stream_id);
+
+    if (!sub)
+        return nullptr;
+
+    return std::unique_ptr<RandIntReader>{new RandIntReader(std::move(sub), SHOW_RAND_)};
+}
+} // namespace io
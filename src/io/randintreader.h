@@ -1,23 +1,36 @@
 #ifndef H_RANDINTREADER
 #define H_RANDINTREADER
 
+#include <cstdint>
 #include <iostream>
-#include <fstream>
+#include <memory>
+
+#include "randsource.h"
 
 namespace io
 {
 class RandIntReader
 {
 public:
-    RandIntReader();
+    RandIntReader(std::unique_ptr<RandomSource> source, bool showrand);
     ~RandIntReader();
     int read_next_int();
     double calc_next_probability();
 
+    uint64_t position() const;
+    void seek(uint64_t position);
+
+    /* Reader over an independent substream; nullptr if the source cannot be split. */
+    std::unique_ptr<RandIntReader> substream(uint64_t stream_id) const;
+
 private:
-    std::ifstream infile_;
+    RandIntReader(const RandIntReader &);
+    RandIntReader &operator=(const RandIntReader &);
+
+    std::unique_ptr<RandomSource> source_;
+    const bool SHOW_RAND_;
     static const int MAX_INT_;
 };
 } // namespace io
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,244 @@
+#include "randnumloader.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace io
+{
+
+namespace
+{
+
+const char SIDECAR_MAGIC[8] = {'R', 'A', 'N', 'D', 'N', 'U', 'M', '1'};
+
+struct SidecarHeader
+{
+    char magic[8];
+    uint64_t source_size;
+    int64_t source_mtime;
+    uint64_t count;
+};
+
+/* Read-only memory mapping of a whole file; unmapped on destruction. */
+class MappedFile
+{
+public:
+    MappedFile(const std::string &path) : fd_(-1), data_(nullptr), size_(0)
+    {
+        fd_ = open(path.c_str(), O_RDONLY);
+
+        if (fd_ < 0 || fstat(fd_, &stat_) != 0)
+            return;
+
+        size_ = (size_t)stat_.st_size;
+
+        if (size_ == 0)
+            return;
+
+        void *addr = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+
+        if (addr == MAP_FAILED)
+        {
+            size_ = 0;
+            return;
+        }
+
+        data_ = static_cast<const char *>(addr);
+        madvise(addr, size_, MADV_SEQUENTIAL);
+    }
+
+    ~MappedFile()
+    {
+        if (data_)
+            munmap(const_cast<char *>(data_), size_);
+        if (fd_ >= 0)
+            close(fd_);
+    }
+
+    bool is_open() const { return fd_ >= 0; }
+    const char *data() const { return data_; }
+    size_t size() const { return size_; }
+    const struct stat &status() const { return stat_; }
+
+private:
+    MappedFile(const MappedFile &);
+    MappedFile &operator=(const MappedFile &);
+
+    int fd_;
+    const char *data_;
+    size_t size_;
+    struct stat stat_;
+};
+
+inline bool is_digit(char c)
+{
+    return (unsigned char)(c - '0') < 10;
+}
+
+/**
+ * SWAR conversion of eight ASCII digits (most significant first) loaded as a
+ * little-endian 64-bit word: pairs, then quads, then the full eight digits are
+ * combined with one multiply-and-shift each.
+ */
+inline uint32_t parse_eight_digits(const char *p)
+{
+    uint64_t chunk;
+    memcpy(&chunk, p, sizeof(chunk));
+
+    chunk -= 0x3030303030303030ULL;
+    chunk = (chunk * 10 + (chunk >> 8)) & 0x00ff00ff00ff00ffULL;
+    chunk = (chunk * 100 + (chunk >> 16)) & 0x0000ffff0000ffffULL;
+    chunk = (chunk * 10000 + (chunk >> 32)) & 0x00000000ffffffffULL;
+
+    return (uint32_t)chunk;
+}
+
+inline bool is_little_endian()
+{
+    const uint16_t probe = 1;
+    return *reinterpret_cast<const unsigned char *>(&probe) == 1;
+}
+
+bool load_sidecar(const std::string &sidecar_path, const struct stat &source, std::vector<int> &numbers)
+{
+    MappedFile sidecar(sidecar_path);
+
+    if (sidecar.size() < sizeof(SidecarHeader))
+        return false;
+
+    SidecarHeader header;
+    memcpy(&header, sidecar.data(), sizeof(header));
+
+    if (memcmp(header.magic, SIDECAR_MAGIC, sizeof(SIDECAR_MAGIC)) != 0 ||
+        header.source_size != (uint64_t)source.st_size ||
+        header.source_mtime != (int64_t)source.st_mtime ||
+        sidecar.size() != sizeof(SidecarHeader) + header.count * sizeof(int32_t))
+        return false;
+
+    numbers.resize(header.count);
+
+    if (header.count > 0)
+        memcpy(&numbers[0], sidecar.data() + sizeof(SidecarHeader), header.count * sizeof(int32_t));
+
+    return true;
+}
+
+void write_sidecar(const std::string &sidecar_path, const struct stat &source, const std::vector<int> &numbers)
+{
+    /**
+     * Written under a temporary name and renamed into place, so a concurrent
+     * run never maps a partially written sidecar. Failures are ignored: the
+     * sidecar is only a cache.
+     */
+
+    std::string tmp_path = sidecar_path + ".tmp" + std::to_string((long long)getpid());
+
+    FILE *out = fopen(tmp_path.c_str(), "wb");
+
+    if (!out)
+        return;
+
+    SidecarHeader header;
+    memcpy(header.magic, SIDECAR_MAGIC, sizeof(SIDECAR_MAGIC));
+    header.source_size = (uint64_t)source.st_size;
+    header.source_mtime = (int64_t)source.st_mtime;
+    header.count = numbers.size();
+
+    bool ok = fwrite(&header, sizeof(header), 1, out) == 1;
+
+    if (ok && !numbers.empty())
+        ok = fwrite(&numbers[0], sizeof(int32_t), numbers.size(), out) == numbers.size();
+
+    ok = (fclose(out) == 0) && ok;
+
+    if (!ok || rename(tmp_path.c_str(), sidecar_path.c_str()) != 0)
+        unlink(tmp_path.c_str());
+}
+
+} // namespace
+
+void parse_random_numbers(const char *begin, const char *end, std::vector<int> &numbers)
+{
+    const char *p = begin;
+
+    while (p < end)
+    {
+        while (p < end && !is_digit(*p) && *p != '-')
+            p++;
+
+        if (p == end)
+            break;
+
+        bool negative = (*p == '-');
+
+        if (negative)
+            p++;
+
+        /* A sign must start a number; stream extraction would have stopped here */
+        if (p == end || !is_digit(*p))
+        {
+            std::cout << "ERROR: Malformed rand-num file: '-' without a number." << std::endl;
+            exit(10);
+        }
+
+        uint64_t value = 0;
+
+        /* Numbers in the file are mostly 9-10 digits; take 8 at once when possible */
+        if (is_little_endian() && end - p >= 8)
+        {
+            bool all_digits = true;
+
+            for (int i = 0; i < 8 && all_digits; i++)
+                all_digits = is_digit(p[i]);
+
+            if (all_digits)
+            {
+                value = parse_eight_digits(p);
+                p += 8;
+            }
+        }
+
+        while (p < end && is_digit(*p))
+        {
+            value = value * 10 + (uint64_t)(*p - '0');
+            p++;
+        }
+
+        numbers.push_back(negative ? -(int)value : (int)value);
+    }
+}
+
+bool load_random_numbers(const std::string &path, std::vector<int> &numbers)
+{
+    numbers.clear();
+
+    MappedFile text(path);
+
+    if (!text.is_open())
+        return false;
+
+    std::string sidecar_path = path + ".bin";
+
+    if (is_little_endian() && load_sidecar(sidecar_path, text.status(), numbers))
+        return true;
+
+    /* Every number takes at least two bytes including its separator */
+    numbers.reserve(text.size() / 2 + 1);
+
+    parse_random_numbers(text.data(), text.data() + text.size(), numbers);
+
+    if (is_little_endian())
+        write_sidecar(sidecar_path, text.status(), numbers);
+
+    return true;
+}
+
+} // namespace io
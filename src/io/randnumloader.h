@@ -0,0 +1,29 @@
+#ifndef H_RANDNUMLOADER
+#define H_RANDNUMLOADER
+
+#include <string>
+#include <vector>
+
+namespace io
+{
+
+/**
+ * Loads the whitespace separated integers of a random number file into a
+ * contiguous array, in file order.
+ *
+ * The text file is memory mapped and parsed once; the parsed array is then
+ * written to a binary sidecar (<path>.bin) which later runs map directly,
+ * as long as the size and modification time of the text file still match.
+ * Returns false if the text file cannot be opened.
+ */
+bool load_random_numbers(const std::string &path, std::vector<int> &numbers);
+
+/**
+ * Parses the integers in [begin, end) and appends them to numbers. Terminates
+ * on a '-' that is not followed by a digit.
+ */
+void parse_random_numbers(const char *begin, const char *end, std::vector<int> &numbers);
+
+} // namespace io
+
+#endif
@@ -0,0 +1,121 @@
+#include "randsource.h"
+
+#include <iostream>
+
+#include "randnumloader.h"
+#include "uin.h"
+
+namespace io
+{
+RandomSource::~RandomSource() {}
+
+FileRandomSource::FileRandomSource(std::shared_ptr<const std::vector<int>> numbers)
+    : numbers_(numbers), ORIGIN_(0), CIRCULAR_(false), cursor_(0) {}
+
+FileRandomSource::FileRandomSource(std::shared_ptr<const std::vector<int>> numbers, uint64_t origin)
+    : numbers_(numbers), ORIGIN_(origin), CIRCULAR_(true), cursor_(0) {}
+
+std::shared_ptr<const std::vector<int>> FileRandomSource::load(const std::string &path)
+{
+    std::shared_ptr<std::vector<int>> numbers = std::make_shared<std::vector<int>>();
+
+    if (!load_random_numbers(path, *numbers))
+        return nullptr;
+
+    return numbers;
+}
+
+int FileRandomSource::next()
+{
+    if (CIRCULAR_)
+        return numbers_->empty() ? 0 : (*numbers_)[(ORIGIN_ + cursor_++) % numbers_->size()];
+
+    /* Past the end of the file, stream extraction used to yield 0; keep that */
+    return (cursor_ < numbers_->size()) ? (*numbers_)[cursor_++] : 0;
+}
+
+uint64_t FileRandomSource::position() const { return cursor_; }
+
+void FileRandomSource::seek(uint64_t position) { cursor_ = position; }
+
+std::unique_ptr<RandomSource> FileRandomSource::substream(uint64_t stream_id) const
+{
+    return nullptr;
+}
+
+const uint64_t CounterRandomSource::GAMMA_ = 0x9e3779b97f4a7c15ULL;
+
+CounterRandomSource::CounterRandomSource(uint64_t seed, uint64_t stream_id)
+    : SEED_(seed), KEY_(mix(seed ^ mix(stream_id + GAMMA_))), counter_(0) {}
+
+uint64_t CounterRandomSource::mix(uint64_t z)
+{
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+int CounterRandomSource::next()
+{
+    counter_++;
+    return (int)(mix(KEY_ + counter_ * GAMMA_) >> 33);
+}
+
+uint64_t CounterRandomSource::position() const { return counter_; }
+
+void CounterRandomSource::seek(uint64_t position) { counter_ = position; }
+
+std::unique_ptr<RandomSource> CounterRandomSource::substream(uint64_t stream_id) const
+{
+    return std::unique_ptr<RandomSource>{new CounterRandomSource(SEED_, stream_id)};
+}
+
+namespace
+{
+std::shared_ptr<const std::vector<int>> load_random_file(const UserInput &uin)
+{
+    std::shared_ptr<const std::vector<int>> numbers = FileRandomSource::load(uin.randfile);
+
+    if (!numbers)
+    {
+        std::cout << "ERROR: Could not open rand-num file." << std::endl;
+        exit(10);
+    }
+
+    return numbers;
+}
+} // namespace
+
+std::unique_ptr<RandomSource> make_random_source(const UserInput &uin)
+{
+    switch (uin.rng)
+    {
+    case RNG_COUNTER:
+        return std::unique_ptr<RandomSource>{new CounterRandomSource(uin.rng_seed, 0)};
+
+    case RNG_FILE:
+    default:
+        return std::unique_ptr<RandomSource>{new FileRandomSource(load_random_file(uin))};
+    }
+}
+
+std::unique_ptr<RandomSource> make_random_source(const UserInput &uin, uint64_t stream_id)
+{
+    switch (uin.rng)
+    {
+    case RNG_COUNTER:
+        return std::unique_ptr<RandomSource>{new CounterRandomSource(uin.rng_seed, stream_id)};
+
+    case RNG_FILE:
+    default:
+        std::shared_ptr<const std::vector<int>> numbers = load_random_file(uin);
+
+        /* Top 32 bits of the fraction of stream_id times the golden ratio, scaled to the file */
+        uint64_t fraction = (stream_id * 0x9e3779b97f4a7c15ULL) >> 32;
+        uint64_t origin = (fraction * (uint64_t)numbers->size()) >> 32;
+
+        return std::unique_ptr<RandomSource>{new FileRandomSource(numbers, origin)};
+    }
+}
+
+} // namespace io
@@ -0,0 +1,98 @@
+#ifndef H_RANDSOURCE
+#define H_RANDSOURCE
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace io
+{
+struct UserInput;
+
+/**
+ * Source of non-negative 31-bit random integers behind io::RandIntReader.
+ * position() counts the numbers drawn so far; seek() moves to any position.
+ */
+class RandomSource
+{
+public:
+    virtual ~RandomSource();
+
+    virtual int next() = 0;
+    virtual uint64_t position() const = 0;
+    virtual void seek(uint64_t position) = 0;
+
+    /* Independent stream for stream_id; nullptr if the source cannot be split. */
+    virtual std::unique_ptr<RandomSource> substream(uint64_t stream_id) const = 0;
+};
+
+/**
+ * Replays the numbers of a random number file, as the lab reference outputs
+ * expect. The file is a single stream and cannot be split. The parsed numbers
+ * are immutable and may be shared by any number of sources, each with its
+ * own cursor.
+ *
+ * A source given an origin reads the file circularly from that number on,
+ * for callers that need a stream of their own but have only the file.
+ */
+class FileRandomSource : public RandomSource
+{
+public:
+    FileRandomSource(std::shared_ptr<const std::vector<int>> numbers);
+    FileRandomSource(std::shared_ptr<const std::vector<int>> numbers, uint64_t origin);
+
+    /* Parsed numbers of the file at path; nullptr if it cannot be opened. */
+    static std::shared_ptr<const std::vector<int>> load(const std::string &path);
+
+    int next() override;
+    uint64_t position() const override;
+    void seek(uint64_t position) override;
+    std::unique_ptr<RandomSource> substream(uint64_t stream_id) const override;
+
+private:
+    std::shared_ptr<const std::vector<int>> numbers_;
+    const uint64_t ORIGIN_;
+    const bool CIRCULAR_;
+    uint64_t cursor_;
+};
+
+/**
+ * Counter-based generator: number n of stream s is the SplitMix64 finalizer
+ * applied to a key derived from (seed, s) plus n times the golden gamma.
+ * Streams are unbounded, any position is reachable in O(1), and every stream
+ * id yields an independent, reproducible substream.
+ */
+class CounterRandomSource : public RandomSource
+{
+public:
+    CounterRandomSource(uint64_t seed, uint64_t stream_id);
+
+    int next() override;
+    uint64_t position() const override;
+    void seek(uint64_t position) override;
+    std::unique_ptr<RandomSource> substream(uint64_t stream_id) const override;
+
+    static uint64_t mix(uint64_t z);
+
+private:
+    const uint64_t SEED_;
+    const uint64_t KEY_;
+    uint64_t counter_;
+
+    static const uint64_t GAMMA_;
+};
+
+std::unique_ptr<RandomSource> make_random_source(const UserInput &uin);
+
+/**
+ * Source for a stream of its own, for callers whose shared reader cannot be
+ * split: substream stream_id of the generator, or the random number file read
+ * circularly from an origin picked by Fibonacci hashing of stream_id, so
+ * streams with nearby ids start far apart in the file.
+ */
+std::unique_ptr<RandomSource> make_random_source(const UserInput &uin, uint64_t stream_id);
+
+} // namespace io
+
+#endif
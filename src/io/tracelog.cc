@@ -0,0 +1,166 @@
+#include "tracelog.h"
+
+#include <cstring>
+
+namespace io
+{
+TraceLog::TraceLog(FILE *stream, size_t capacity)
+    : stream_(stream), active_(capacity), writing_(capacity), size_(0),
+      pending_(0), stopping_(false) {}
+
+TraceLog::~TraceLog()
+{
+    use_writer_thread(false);
+    flush();
+}
+
+TraceLog &TraceLog::operator<<(int value)
+{
+    /* Digits are produced backwards into a scratch buffer, then copied once */
+
+    char digits[12];
+    char *end = digits + sizeof(digits);
+    char *p = end;
+
+    unsigned int magnitude = (value < 0) ? 0u - (unsigned int)value : (unsigned int)value;
+
+    do
+    {
+        *--p = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+
+    if (value < 0)
+        *--p = '-';
+
+    append(p, end - p);
+    return *this;
+}
+
+TraceLog &TraceLog::operator<<(char c)
+{
+    append(&c, 1);
+    return *this;
+}
+
+void TraceLog::append(const char *text, size_t length)
+{
+    if (size_ + length > active_.size())
+    {
+        spill();
+
+        if (length > active_.size())
+        {
+            /* Written inline, so the buffer just handed to the writer must go out first */
+            if (writer_.joinable())
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wait_until_idle(lock);
+            }
+
+            fwrite(text, 1, length, stream_);
+            return;
+        }
+    }
+
+    memcpy(active_.data() + size_, text, length);
+    size_ += length;
+}
+
+void TraceLog::spill()
+{
+    if (size_ == 0)
+        return;
+
+    if (!writer_.joinable())
+    {
+        fwrite(active_.data(), 1, size_, stream_);
+        size_ = 0;
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    wait_until_idle(lock);
+
+    active_.swap(writing_);
+    pending_ = size_;
+    size_ = 0;
+
+    work_ready_.notify_one();
+}
+
+void TraceLog::wait_until_idle(std::unique_lock<std::mutex> &lock)
+{
+    while (pending_ != 0)
+        work_done_.wait(lock);
+}
+
+void TraceLog::flush()
+{
+    if (writer_.joinable())
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        wait_until_idle(lock);
+    }
+
+    if (size_ > 0)
+    {
+        fwrite(active_.data(), 1, size_, stream_);
+        size_ = 0;
+    }
+
+    fflush(stream_);
+}
+
+void TraceLog::use_writer_thread(bool enabled)
+{
+    if (enabled == writer_.joinable())
+        return;
+
+    if (enabled)
+    {
+        stopping_ = false;
+        writer_ = std::thread(&TraceLog::run_writer, this);
+        return;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        wait_until_idle(lock);
+        stopping_ = true;
+        work_ready_.notify_one();
+    }
+
+    writer_.join();
+}
+
+void TraceLog::run_writer()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (true)
+    {
+        while (pending_ == 0 && !stopping_)
+            work_ready_.wait(lock);
+
+        if (pending_ == 0)
+            return;
+
+        size_t length = pending_;
+
+        lock.unlock();
+        fwrite(writing_.data(), 1, length, stream_);
+        lock.lock();
+
+        pending_ = 0;
+        work_done_.notify_all();
+    }
+}
+
+TraceLog &trace_log()
+{
+    static TraceLog log(stdout, 1 << 20);
+    return log;
+}
+
+} // namespace io
@@ -0,0 +1,73 @@
+#ifndef H_TRACELOG
+#define H_TRACELOG
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace io
+{
+/**
+ * Buffered writer for the per-reference debug and show-random lines. Text is
+ * formatted straight into a large preallocated buffer (integers by a small
+ * hand-rolled formatter) and written to the stream in big chunks, optionally
+ * by a background writer thread while the next buffer fills.
+ *
+ * It writes through stdio, like std::cout, so the two interleave correctly as
+ * long as the log is flushed before std::cout prints after it: flush() the
+ * log ahead of any std::cout output that follows traced references.
+ */
+class TraceLog
+{
+public:
+    TraceLog(FILE *stream, size_t capacity);
+    ~TraceLog();
+
+    template <size_t N>
+    TraceLog &operator<<(const char (&literal)[N])
+    {
+        append(literal, N - 1);
+        return *this;
+    }
+
+    TraceLog &operator<<(int value);
+    TraceLog &operator<<(char c);
+
+    /* Writes out everything buffered so far and flushes the stream. */
+    void flush();
+
+    /* Hands full buffers to a background writer thread instead of writing them inline. */
+    void use_writer_thread(bool enabled);
+
+private:
+    TraceLog(const TraceLog &);
+    TraceLog &operator=(const TraceLog &);
+
+    void append(const char *text, size_t length);
+    void spill();
+    void wait_until_idle(std::unique_lock<std::mutex> &lock);
+    void run_writer();
+
+    FILE *stream_;
+
+    std::vector<char> active_;  /* buffer being filled */
+    std::vector<char> writing_; /* buffer owned by the writer thread */
+    size_t size_;
+
+    std::thread writer_;
+    std::mutex mutex_;
+    std::condition_variable work_ready_;
+    std::condition_variable work_done_;
+    size_t pending_;
+    bool stopping_;
+};
+
+/* The log on standard output shared by the pager, the driver and the random number reader. */
+TraceLog &trace_log();
+
+} // namespace io
+
+#endif
@@ -4,6 +4,7 @@
 #include <sstream>
 #include <fstream>
 #include <algorithm>
+#include <vector>
 
 namespace io
 {
@@ -21,6 +22,27 @@ pager::AlgoName map_to_algoname(std::string raw_algoname)
     else if (raw_algoname == "random")
         return pager::RANDOM;
 
+    else if (raw_algoname == "opt")
+        return pager::OPT;
+
+    else if (raw_algoname == "clock")
+        return pager::CLOCK;
+
+    else if (raw_algoname == "esc")
+        return pager::ESC;
+
+    else if (raw_algoname == "gclock")
+        return pager::GCLOCK;
+
+    else if (raw_algoname == "arc")
+        return pager::ARC;
+
+    else if (raw_algoname == "2q")
+        return pager::TWOQ;
+
+    else if (raw_algoname == "lirs")
+        return pager::LIRS;
+
     else
     {
         std::cout << "The algorithm name entered is not correct. Please double check." << std::endl;
@@ -28,9 +50,20 @@ pager::AlgoName map_to_algoname(std::string raw_algoname)
     }
 }
 
-io::UserInput read_predefined_input(int argc, char **argv)
+bool parse_input_line(const std::string &line, io::UserInput &uin)
 {
-    io::UserInput uin = io::UserInput();
+    std::istringstream iss(line);
+
+    if (!(iss >> uin.machine_size >> uin.page_size >> uin.proc_size >> uin.jobmix >> uin.ref_count >> uin.raw_algoname))
+        return false;
+
+    uin.algoname = map_to_algoname(uin.raw_algoname);
+    return true;
+}
+
+io::UserInput read_predefined_input(int argc, char **argv, const io::UserInput &defaults)
+{
+    io::UserInput uin = defaults;
 
     int input_id;
 
@@ -77,7 +110,7 @@ io::UserInput read_predefined_input(int argc, char **argv)
 
     int line_ctr = 0;
 
-    std::fstream infile("src/io/sample-in.txt");
+    std::fstream infile(uin.inputfile);
 
     if (infile)
     {
@@ -91,15 +124,12 @@ io::UserInput read_predefined_input(int argc, char **argv)
                 continue;
             }
 
-            std::istringstream iss(line);
-
-            if (!(iss >> uin.machine_size >> uin.page_size >> uin.proc_size >> uin.jobmix >> uin.ref_count >> uin.raw_algoname))
+            if (!parse_input_line(line, uin))
             {
                 std::cout << "Text file corrupted. Terminating..." << std::endl;
                 exit(10);
             }
 
-            uin.algoname = map_to_algoname(uin.raw_algoname);
             break;
         }
 
@@ -116,9 +146,9 @@ io::UserInput read_predefined_input(int argc, char **argv)
     return uin;
 }
 
-io::UserInput read_custom_input(int argc, char **argv)
+io::UserInput read_custom_input(int argc, char **argv, const io::UserInput &defaults)
 {
-    io::UserInput uin = io::UserInput();
+    io::UserInput uin = defaults;
 
     try
     {
@@ -146,15 +176,380 @@ io::UserInput read_custom_input(int argc, char **argv)
     return uin;
 }
 
+void apply_option(const std::string &name, const std::string &value, io::UserInput &uin)
+{
+    if (name == "rng")
+    {
+        if (value == "file")
+            uin.rng = RNG_FILE;
+
+        else if (value == "splitmix64" || value == "counter")
+            uin.rng = RNG_COUNTER;
+
+        else
+        {
+            std::cout << "Unknown random source `" << value << "`. Terminating..." << std::endl;
+            exit(10);
+        }
+    }
+    else if (name == "seed")
+    {
+        uin.rng_seed = std::stoull(value);
+    }
+    else if (name == "randfile")
+    {
+        uin.randfile = value;
+    }
+    else if (name == "inputfile")
+    {
+        uin.inputfile = value;
+    }
+    else if (name == "jobmixfile")
+    {
+        uin.jobmixfile = value;
+    }
+    else if (name == "sweep")
+    {
+        uin.sweepfile = value;
+    }
+    else if (name == "grid")
+    {
+        uin.sweepgrid = value;
+    }
+    else if (name == "threads")
+    {
+        uin.threads = std::stoi(value);
+    }
+    else if (name == "record")
+    {
+        uin.record_trace = value;
+    }
+    else if (name == "replay")
+    {
+        uin.replay_trace = value;
+    }
+    else if (name == "compare")
+    {
+        uin.lockstep = value;
+    }
+    else if (name == "trace-writer")
+    {
+        if (value == "thread")
+            uin.trace_thread = true;
+
+        else if (value == "inline")
+            uin.trace_thread = false;
+
+        else
+        {
+            std::cout << "Unknown trace writer `" << value << "`. Terminating..." << std::endl;
+            exit(10);
+        }
+    }
+    else if (name == "shards-rate")
+    {
+        uin.shards_rate = std::stod(value);
+
+        if (!(uin.shards_rate > 0 && uin.shards_rate <= 1))
+        {
+            std::cout << "The sampling rate must be in (0, 1]. Terminating..." << std::endl;
+            exit(10);
+        }
+    }
+    else if (name == "shards-max")
+    {
+        uin.shards_max = std::stoi(value);
+
+        if (uin.shards_max < 1)
+        {
+            std::cout << "The sample limit must be positive. Terminating..." << std::endl;
+            exit(10);
+        }
+    }
+    else if (name == "mrc-frames")
+    {
+        uin.mrc_frames = value;
+    }
+    else if (name == "mrc-validate")
+    {
+        uin.mrc_validate = (value == "1");
+    }
+    else if (name == "tlb")
+    {
+        uin.tlb.entries = std::stoi(value);
+    }
+    else if (name == "tlb-ways")
+    {
+        uin.tlb.ways = std::stoi(value);
+    }
+    else if (name == "tlb-replacement")
+    {
+        if (value == "lru")
+            uin.tlb.replacement = pager::TLB_LRU;
+
+        else if (value == "random")
+            uin.tlb.replacement = pager::TLB_RANDOM;
+
+        else
+        {
+            std::cout << "Unknown TLB replacement `" << value << "`. Terminating..." << std::endl;
+            exit(10);
+        }
+    }
+    else if (name == "tlb-flush")
+    {
+        if (value == "asid")
+            uin.tlb.flush_on_switch = false;
+
+        else if (value == "switch")
+            uin.tlb.flush_on_switch = true;
+
+        else
+        {
+            std::cout << "Unknown TLB flush mode `" << value << "`. Terminating..." << std::endl;
+            exit(10);
+        }
+    }
+    else if (name == "tlb-cycles")
+    {
+        size_t comma = value.find(',');
+        uin.tlb.hit_cycles = std::stoi(value.substr(0, comma));
+
+        if (comma != std::string::npos)
+            uin.tlb.miss_cycles = std::stoi(value.substr(comma + 1));
+    }
+    else if (name == "cost")
+    {
+        uin.cost.enabled = (value == "1");
+    }
+    else if (name == "cost-cycles")
+    {
+        std::istringstream iss(value);
+        char sep1, sep2;
+
+        if (!(iss >> uin.cost.access_cycles >> sep1 >> uin.cost.fault_cycles >> sep2 >> uin.cost.eviction_cycles) ||
+            sep1 != ',' || sep2 != ',')
+        {
+            std::cout << "The cost cycles must be given as `access,fault,eviction`. Terminating..." << std::endl;
+            exit(10);
+        }
+
+        uin.cost.enabled = true;
+    }
+    else if (name == "tiers")
+    {
+        uin.cost.tiers.clear();
+
+        std::istringstream tiers(value);
+        std::string spec;
+
+        while (std::getline(tiers, spec, ','))
+        {
+            std::istringstream fields(spec);
+            std::string latency, capacity;
+            pager::BackingTier tier;
+
+            std::getline(fields, tier.name, ':');
+            std::getline(fields, latency, ':');
+            std::getline(fields, capacity);
+
+            if (tier.name.empty() || latency.empty())
+            {
+                std::cout << "Backing tiers must be given as `name:latency[:capacity]`. Terminating..." << std::endl;
+                exit(10);
+            }
+
+            tier.latency = std::stoll(latency);
+            tier.capacity = capacity.empty() ? 0 : std::stoll(capacity);
+
+            if (tier.latency < 0 || tier.capacity < 0)
+            {
+                std::cout << "Tier latencies and capacities must not be negative. Terminating..." << std::endl;
+                exit(10);
+            }
+
+            uin.cost.tiers.push_back(tier);
+        }
+
+        if (uin.cost.tiers.empty())
+        {
+            std::cout << "At least one backing tier is needed. Terminating..." << std::endl;
+            exit(10);
+        }
+
+        uin.cost.enabled = true;
+    }
+    else if (name == "write-ratio")
+    {
+        uin.write_ratio = std::stod(value);
+
+        if (!(uin.write_ratio >= 0 && uin.write_ratio <= 1))
+        {
+            std::cout << "The write ratio must be in [0, 1]. Terminating..." << std::endl;
+            exit(10);
+        }
+    }
+    else if (name == "sched")
+    {
+        size_t colon = value.find(':');
+        std::string kind = value.substr(0, colon);
+
+        if (kind == "rr")
+            uin.sched = SCHEDULE_ROUND_ROBIN;
+
+        else if (kind == "random")
+            uin.sched = SCHEDULE_RANDOM;
+
+        else if (kind == "lottery")
+            uin.sched = SCHEDULE_LOTTERY;
+
+        else
+        {
+            std::cout << "Unknown scheduler `" << kind << "`. Terminating..." << std::endl;
+            exit(10);
+        }
+
+        if (colon != std::string::npos)
+            uin.quantum = std::stoi(value.substr(colon + 1));
+
+        if (uin.quantum < 1)
+        {
+            std::cout << "The quantum must be positive. Terminating..." << std::endl;
+            exit(10);
+        }
+    }
+    else if (name == "cpus")
+    {
+        uin.cpus = std::stoi(value);
+
+        if (uin.cpus < 0)
+        {
+            std::cout << "The number of CPUs must not be negative. Terminating..." << std::endl;
+            exit(10);
+        }
+    }
+    else if (name == "cpu-mode")
+    {
+        if (value == "deterministic")
+            uin.cpu_mode = CPU_DETERMINISTIC;
+
+        else if (value == "relaxed")
+            uin.cpu_mode = CPU_RELAXED;
+
+        else
+        {
+            std::cout << "Unknown CPU mode `" << value << "`. Terminating..." << std::endl;
+            exit(10);
+        }
+    }
+    else if (name == "shards")
+    {
+        uin.shards = std::stoi(value);
+
+        if (uin.shards < 0)
+        {
+            std::cout << "The number of shards must not be negative. Terminating..." << std::endl;
+            exit(10);
+        }
+    }
+    else if (name == "histograms")
+    {
+        if (value == "1")
+            uin.histograms = true;
+
+        else if (value == "0")
+            uin.histograms = false;
+
+        else
+        {
+            std::cout << "Unknown histograms mode `" << value << "`. Terminating..." << std::endl;
+            exit(10);
+        }
+    }
+    else if (name == "mrc")
+    {
+        if (value == "exact" || value == "1")
+            uin.mrc = MRC_EXACT;
+
+        else if (value == "shards")
+            uin.mrc = MRC_SHARDS;
+
+        else if (value == "0")
+            uin.mrc = MRC_OFF;
+
+        else
+        {
+            std::cout << "Unknown miss ratio curve mode `" << value << "`. Terminating..." << std::endl;
+            exit(10);
+        }
+    }
+    else
+    {
+        std::cout << "Unknown option `--" << name << "`. Terminating..." << std::endl;
+        exit(10);
+    }
+}
+
 io::UserInput read_input(const int &argc, char **argv)
 {
-    if (argc >= 2 && argc <= 4)
+    /**
+     * Options of the form `--name=value` may appear anywhere; they are applied
+     * first, so the positional arguments may refer to the files they name.
+     */
+
+    std::vector<char *> args;
+    std::vector<std::pair<std::string, std::string>> options;
+
+    for (int i = 0; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        size_t eq = arg.find('=');
+
+        if (i > 0 && arg.compare(0, 2, "--") == 0 && eq != std::string::npos)
+            options.push_back(std::make_pair(arg.substr(2, eq - 2), arg.substr(eq + 1)));
+        else
+            args.push_back(argv[i]);
+    }
+
+    io::UserInput defaults;
+
+    try
+    {
+        for (auto &option : options)
+            apply_option(option.first, option.second, defaults);
+    }
+    catch (const std::exception &e)
+    {
+        std::cout << "An error has occured while reading user input. Terminating..." << std::endl;
+        std::cerr << e.what() << '\n';
+        exit(10);
+    }
+
+    if (defaults.tlb.entries != 0)
+    {
+        if (defaults.tlb.ways == 0)
+            defaults.tlb.ways = defaults.tlb.entries;
+
+        if (defaults.tlb.entries < 0 || defaults.tlb.ways < 1 || defaults.tlb.entries % defaults.tlb.ways != 0)
+        {
+            std::cout << "The TLB entries must be a positive multiple of its ways. Terminating..." << std::endl;
+            exit(10);
+        }
+    }
+
+    int nargs = (int)args.size();
+
+    if (nargs == 1 && defaults.is_sweep())
+    {
+        return defaults;
+    }
+    else if (nargs >= 2 && nargs <= 4)
     {
-        return read_predefined_input(argc, argv);
+        return read_predefined_input(nargs, &args[0], defaults);
     }
-    else if (argc >= 7 && argc <= 9)
+    else if (nargs >= 7 && nargs <= 9)
     {
-        return read_custom_input(argc, argv);
+        return read_custom_input(nargs, &args[0], defaults);
     }
     else
     {
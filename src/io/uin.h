@@ -1,10 +1,40 @@
 #pragma once
 
+#include <cstdint>
+#include <string>
+
 #include "../pager/pager.h"
+#include "../pager/tlb.h"
 
 namespace io
 {
 
+enum RngKind
+{
+    RNG_FILE,   /* src/io/random-numbers.txt, as in the lab reference outputs */
+    RNG_COUNTER /* counter-based SplitMix64, one substream per process */
+};
+
+enum MrcMode
+{
+    MRC_OFF,
+    MRC_EXACT, /* Mattson stack simulation of every reference (LRU) */
+    MRC_SHARDS /* spatially hashed sampling (LRU and FIFO) */
+};
+
+enum SchedKind
+{
+    SCHEDULE_ROUND_ROBIN, /* round robin, as in the lab */
+    SCHEDULE_RANDOM,      /* uniformly random process at every quantum */
+    SCHEDULE_LOTTERY      /* random process weighted by its job mix tickets */
+};
+
+enum CpuMode
+{
+    CPU_DETERMINISTIC, /* CPUs take turns on a logical clock; reproducible */
+    CPU_RELAXED        /* CPUs run freely, with a clock of their own */
+};
+
 struct UserInput
 {
     int machine_size;
@@ -16,12 +46,65 @@ struct UserInput
     pager::AlgoName algoname;
     bool debug;
     bool showrand;
+    RngKind rng;
+    uint64_t rng_seed;
+
+    std::string randfile;   /* random numbers read by RNG_FILE */
+    std::string inputfile;  /* predefined inputs selected by `./exec [input-number]` */
+    std::string jobmixfile; /* further job mixes, loaded before the run (see driver::jobmixspecs) */
+
+    std::string sweepfile; /* list of configurations to sweep, one per line */
+    std::string sweepgrid; /* grid of configurations to sweep */
+    int threads;           /* worker threads of a sweep; 0 for one per core */
+
+    MrcMode mrc; /* also profile the miss ratio curve, exactly or by sampling */
+
+    double shards_rate;     /* initial sampling rate of MRC_SHARDS */
+    int shards_max;         /* distinct pages MRC_SHARDS may track */
+    std::string mrc_frames; /* frame counts of the sampled curves */
+    bool mrc_validate;      /* check the sampled curves against exact pagers */
+
+    std::string record_trace; /* binary trace file to record references to */
+    std::string replay_trace; /* binary trace file to replay instead of generating references */
+
+    std::string lockstep; /* further `R` or `R@M` pagers fed the same reference stream */
+
+    bool trace_thread; /* write debug and show-random output from a background thread */
+
+    bool histograms; /* also report residency, inter-fault and reuse time percentiles */
+
+    pager::TlbConfig tlb; /* simulated TLB in front of the pager; none if tlb.entries is 0 */
+
+    pager::CostConfig cost; /* cycles charged to hits, faults, evictions and write-backs */
+    double write_ratio;     /* fraction of references that dirty their page */
+
+    SchedKind sched; /* scheduling discipline of every run queue */
+    int quantum;     /* references a process runs before the scheduler picks again */
+
+    int cpus;         /* simulated CPUs run on threads of their own; 0 for the single-queue driver */
+    CpuMode cpu_mode; /* how the CPUs are interleaved */
+    int shards;       /* shards of the concurrent pager; 0 for four per CPU */
 
     UserInput()
         : machine_size(-1), page_size(-1), proc_size(-1),
-          jobmix(-1), ref_count(-1), debug(false), showrand(false){};
+          jobmix(-1), ref_count(-1), algoname(pager::LRU), debug(false), showrand(false),
+          rng(RNG_FILE), rng_seed(0),
+          randfile("src/io/random-numbers.txt"), inputfile("src/io/sample-in.txt"),
+          threads(0), mrc(MRC_OFF), shards_rate(0.01), shards_max(8192), mrc_validate(false),
+          trace_thread(false), histograms(false), write_ratio(0),
+          sched(SCHEDULE_ROUND_ROBIN), quantum(3),
+          cpus(0), cpu_mode(CPU_DETERMINISTIC), shards(0){};
+
+    bool is_sweep() const { return !sweepfile.empty() || !sweepgrid.empty(); }
+    bool is_lockstep() const { return !lockstep.empty(); }
+    bool is_multicpu() const { return cpus > 0; }
 };
 
 io::UserInput read_input(const int &argc, char **argv);
 
+pager::AlgoName map_to_algoname(std::string raw_algoname);
+
+/* Reads `M P S J N R` from a line of a predefined input file into uin. */
+bool parse_input_line(const std::string &line, io::UserInput &uin);
+
 } // namespace io
\ No newline at end of file
@@ -1,28 +1,45 @@
 #include "io/randintreader.h"
 #include "io/uin.h"
+#include "io/tracelog.h"
 #include "driver/driver.h"
+#include "driver/jobmixspec.h"
 #include "pager/pager.h"
+#include "pager/pagerfactory.h"
+#include "pager/fanoutsink.h"
+#include "pager/tlb.h"
+#include "mrc/stackprofiler.h"
+#include "mrc/shardsprofiler.h"
+#include "mrc/shardsreport.h"
+#include "trace/nextuse.h"
+#include "trace/tracebuffer.h"
+#include "trace/tracereader.h"
+#include "trace/tracewriter.h"
+#include "sweep/sweep.h"
+#include "sweep/lockstep.h"
+#include "sweep/multicpu.h"
 #include "debug.h"
 
-namespace demandpaging
+int main(int argc, char **argv)
 {
+    io::UserInput uin = io::read_input(argc, argv);
 
-static bool debug_status;
-static bool show_rand;
+    if (uin.trace_thread)
+        io::trace_log().use_writer_thread(true);
 
-bool debug() { return debug_status; }
-bool showrand() { return show_rand; }
+    if (!uin.jobmixfile.empty())
+        driver::jobmixspecs::load_jobmix_file(uin.jobmixfile);
 
-} // namespace demandpaging
+    if (uin.is_sweep())
+    {
+        sweep::execute(uin);
+        return 0;
+    }
 
-int main(int argc, char **argv)
-{
-    namespace dp = demandpaging;
-
-    io::UserInput uin = io::read_input(argc, argv);
-
-    dp::debug_status = uin.debug;
-    dp::show_rand = uin.showrand;
+    if (!driver::jobmixspecs::get_jobmix(uin.jobmix))
+    {
+        std::cout << "Job mix " << uin.jobmix << " is not defined. Terminating..." << std::endl;
+        exit(10);
+    }
 
     std::cout << "\nThe machine size is " << uin.machine_size << ".\n"
               << "The page size is " << uin.page_size << ".\n"
@@ -30,15 +47,143 @@ int main(int argc, char **argv)
               << "The job mix number is " << uin.jobmix << ".\n"
               << "The number of references per process is " << uin.ref_count << ".\n"
               << "The replacement algorithm is " << uin.raw_algoname << ".\n"
-              << "The level of debugging output is " << dp::debug_status << ".\n"
+              << "The level of debugging output is " << uin.debug << ".\n"
               << std::endl;
 
-    io::RandIntReader randintreader;
+    if (uin.is_lockstep())
+    {
+        sweep::execute_lockstep(uin);
+        return 0;
+    }
+
+    if (uin.is_multicpu())
+    {
+        sweep::execute_multicpu(uin);
+        return 0;
+    }
+
+    io::RandIntReader randintreader(io::make_random_source(uin), uin.showrand);
+
+    std::unique_ptr<trace::TraceReader> replay;
+
+    if (!uin.replay_trace.empty())
+    {
+        replay.reset(new trace::TraceReader(uin.replay_trace));
+
+        if (!replay->is_valid())
+        {
+            std::cout << "ERROR: Could not read trace file " << uin.replay_trace << "." << std::endl;
+            exit(10);
+        }
+    }
+
+    /* OPT needs the whole stream up front: take it from the trace, or generate it first */
+
+    trace::TraceBuffer generated;
+    std::vector<uint64_t> next_use;
+
+    if (uin.algoname == pager::OPT)
+    {
+        if (replay)
+        {
+            next_use = trace::compute_next_use(replay->begin(), replay->end(), uin.page_size);
+        }
+        else
+        {
+            driver::Driver generator(uin, generated, randintreader);
+            generator.execute();
+            next_use = trace::compute_next_use(generated.begin(), generated.end(), uin.page_size);
+        }
+    }
+
+    std::unique_ptr<pager::PagerBase> pager = pager::make_pager(uin, randintreader, &next_use);
+    pager::ReferenceSink *sink = pager.get();
+
+    std::unique_ptr<pager::Tlb> tlb;
+
+    if (uin.tlb.entries > 0)
+    {
+        tlb.reset(new pager::Tlb(uin.tlb, uin.page_size, *sink));
+        pager->set_eviction_listener(tlb.get());
+        sink = tlb.get();
+    }
+
+    std::unique_ptr<mrc::StackProfiler> profiler;
+
+    if (uin.mrc == io::MRC_EXACT)
+    {
+        profiler.reset(new mrc::StackProfiler(uin.page_size, sink));
+        sink = profiler.get();
+    }
+
+    std::unique_ptr<mrc::ShardsProfiler> sampler;
+    trace::TraceBuffer validation_stream;
+    pager::FanOutSink validation_tee;
+
+    if (uin.mrc == io::MRC_SHARDS)
+    {
+        sampler.reset(new mrc::ShardsProfiler(uin.page_size, uin.shards_rate, uin.shards_max,
+                                              mrc::curve_frame_counts(uin), sink));
+        sink = sampler.get();
+
+        if (uin.mrc_validate)
+        {
+            validation_tee.add(*sink);
+            validation_tee.add(validation_stream);
+            sink = &validation_tee;
+        }
+    }
+
+    std::unique_ptr<trace::TraceWriter> recorder;
+
+    if (!uin.record_trace.empty())
+    {
+        recorder.reset(new trace::TraceWriter(uin.record_trace, sink));
+
+        if (!recorder->is_open())
+        {
+            std::cout << "ERROR: Could not create trace file " << uin.record_trace << "." << std::endl;
+            exit(10);
+        }
+
+        sink = recorder.get();
+    }
+
+    if (replay)
+    {
+        replay->replay(*sink);
+    }
+    else if (uin.algoname == pager::OPT)
+    {
+        generated.replay(*sink);
+    }
+    else
+    {
+        driver::Driver driver(uin, *sink, randintreader);
+        driver.execute();
+    }
+
+    if (recorder)
+        recorder->close();
+
+    io::trace_log().flush();
+    pager->print_process_stats_map();
+    pager->print_process_histograms(std::cout);
+
+    if (pager->cost_model())
+        pager->cost_model()->print_costs(std::cout);
+
+    if (tlb)
+        tlb->print_tlb_stats(std::cout);
+
+    if (profiler)
+        profiler->print_miss_ratio_curve(std::cout);
 
-    pager::Pager pager = pager::Pager(uin, randintreader);
-    driver::Driver driver = driver::Driver(uin, pager, randintreader);
+    if (sampler)
+        sampler->print_miss_ratio_curves(std::cout);
 
-    driver.execute();
+    if (sampler && uin.mrc_validate)
+        mrc::print_shards_validation(*sampler, validation_stream, uin, std::cout);
 
     return 0;
-}
\ No newline at end of file
+}
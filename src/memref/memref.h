@@ -1,24 +1,69 @@
 #pragma once
 
-namespace pager
-{
-class Pager;
-}
-
 namespace memref
 {
 
-class Reference
+/**
+ * Value-type description of the next memory reference of a process. It is
+ * small enough to live inline in driver::Process, so generating a reference
+ * needs neither a heap allocation nor a virtual call.
+ */
+struct Reference
 {
-public:
-    Reference(int pid, int delta);
-    virtual ~Reference();
-    Reference &operator=(Reference &rhs);
-    virtual int simulate(int prior_refnum, int proc_size, pager::Pager &pager, int time_accessed);
-
-protected:
-    int pid_;
-    int delta_;
-    static const int INIT_FACTOR_;
+    enum Kind
+    {
+        INITIAL,
+        SEQUENTIAL,
+        BACKWARD,
+        JUMP,
+        RANDOM
+    };
+
+    Kind kind;
+    int delta;
+    int randnum;
+
+    static Reference initial() { return Reference(INITIAL, 1, 0); }
+    static Reference sequential() { return Reference(SEQUENTIAL, 1, 0); }
+    static Reference backward() { return Reference(BACKWARD, -5, 0); }
+    static Reference jump() { return Reference(JUMP, 4, 0); }
+    static Reference random(int randnum) { return Reference(RANDOM, 0, randnum); }
+
+    int next_addr(int prior_refnum, int proc_size, int pid) const
+    {
+        switch (kind)
+        {
+        case INITIAL:
+            return (INIT_FACTOR_ * pid) % proc_size;
+        case RANDOM:
+            return (randnum + proc_size) % proc_size;
+        default:
+            /**
+             * (prior + delta + S) % S without the division: prior is in
+             * [0, S) and |delta| <= MAX_DELTA_, so once S exceeds it a
+             * single correction either way is enough.
+             */
+            if (proc_size > MAX_DELTA_)
+            {
+                int addr = prior_refnum + delta;
+
+                if (addr >= proc_size)
+                    addr -= proc_size;
+                else if (addr < 0)
+                    addr += proc_size;
+
+                return addr;
+            }
+
+            return (prior_refnum + delta + proc_size) % proc_size;
+        }
+    }
+
+private:
+    Reference(Kind kind, int delta, int randnum) : kind(kind), delta(delta), randnum(randnum) {}
+
+    static const int INIT_FACTOR_ = 111;
+    static const int MAX_DELTA_ = 5; /* largest |delta| of sequential, backward and jump */
 };
-} // namespace memref
\ No newline at end of file
+
+} // namespace memref
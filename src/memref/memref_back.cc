@@ -1,8 +0,0 @@
-#include "memref_back.h"
-
-namespace memref
-{
-
-BackwardReference::BackwardReference(int pid) : Reference(pid, -5) {}
-
-}
\ No newline at end of file
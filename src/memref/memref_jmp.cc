@@ -1,8 +0,0 @@
-#include "memref_jmp.h"
-
-namespace memref
-{
-
-JumpReference::JumpReference(int pid) : Reference(pid, 4) {}
-
-}
\ No newline at end of file
@@ -1,8 +0,0 @@
-#include "memref_seq.h"
-
-namespace memref
-{
-
-SequentialReference::SequentialReference(int pid) : Reference(pid, 1) {}
-
-} // namespace memref
\ No newline at end of file
@@ -0,0 +1,64 @@
+#include "fenwick.h"
+
+namespace mrc
+{
+FenwickTree::FenwickTree(int64_t size) : tree_(size + 1, 0), marks_(size + 1, 0) {}
+
+int64_t FenwickTree::size() const { return (int64_t)tree_.size() - 1; }
+
+bool FenwickTree::is_marked(int64_t pos) const { return marks_[pos] != 0; }
+
+void FenwickTree::mark(int64_t pos)
+{
+    if (marks_[pos])
+        return;
+
+    marks_[pos] = 1;
+    add(pos, 1);
+}
+
+void FenwickTree::unmark(int64_t pos)
+{
+    if (!marks_[pos])
+        return;
+
+    marks_[pos] = 0;
+    add(pos, -1);
+}
+
+void FenwickTree::add(int64_t pos, int64_t delta)
+{
+    int64_t n = size();
+
+    for (; pos <= n; pos += pos & (-pos))
+        tree_[pos] += delta;
+}
+
+int64_t FenwickTree::prefix_count(int64_t pos) const
+{
+    int64_t count = 0;
+
+    for (; pos > 0; pos -= pos & (-pos))
+        count += tree_[pos];
+
+    return count;
+}
+
+void FenwickTree::grow()
+{
+    /* Rebuilt in O(n) from the marks: each node pushes its sum to its parent */
+    int64_t n = 2 * (size() > 0 ? size() : 1);
+
+    marks_.resize(n + 1, 0);
+    tree_.assign(n + 1, 0);
+
+    for (int64_t i = 1; i <= n; i++)
+    {
+        tree_[i] += marks_[i];
+
+        int64_t parent = i + (i & (-i));
+        if (parent <= n)
+            tree_[parent] += tree_[i];
+    }
+}
+} // namespace mrc
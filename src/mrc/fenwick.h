@@ -0,0 +1,35 @@
+#ifndef H_FENWICK
+#define H_FENWICK
+
+#include <cstdint>
+#include <vector>
+
+namespace mrc
+{
+/* Binary indexed tree over positions 1..size() of 0/1 marks. */
+class FenwickTree
+{
+public:
+    FenwickTree(int64_t size);
+
+    int64_t size() const;
+    bool is_marked(int64_t pos) const;
+
+    void mark(int64_t pos);
+    void unmark(int64_t pos);
+
+    /* Number of marked positions in [1, pos]. */
+    int64_t prefix_count(int64_t pos) const;
+
+    /* Doubles the capacity, keeping all marks. */
+    void grow();
+
+private:
+    void add(int64_t pos, int64_t delta);
+
+    std::vector<int64_t> tree_;
+    std::vector<char> marks_;
+};
+} // namespace mrc
+
+#endif
@@ -0,0 +1,237 @@
+#include "shardsprofiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace mrc
+{
+const int ShardsProfiler::HASH_BITS_ = 24;
+
+namespace
+{
+uint32_t threshold_for(double rate, int hash_bits)
+{
+    double scaled = std::ceil(rate * (double)(1u << hash_bits));
+    return (uint32_t)std::max(1.0, std::min(scaled, (double)(1u << hash_bits)));
+}
+
+int64_t tree_capacity(int max_samples)
+{
+    return std::max<int64_t>(1024, 4 * (int64_t)max_samples);
+}
+} // namespace
+
+ShardsProfiler::ShardsProfiler(int page_size, double rate, int max_samples,
+                               const std::vector<int> &frame_counts, pager::ReferenceSink *downstream)
+    : PAGE_SIZE_(page_size), MAX_SAMPLES_(max_samples),
+      FIFO_THRESHOLD_(threshold_for(rate, HASH_BITS_)), downstream_(downstream),
+      reference_count_(0), fifo_sampled_count_(0),
+      threshold_(FIFO_THRESHOLD_), tree_(tree_capacity(max_samples)), clock_(0), cold_weight_(0), total_weight_(0),
+      frame_counts_(frame_counts)
+{
+    double fifo_rate = FIFO_THRESHOLD_ / (double)(1u << HASH_BITS_);
+
+    for (int frames : frame_counts_)
+        fifos_.push_back(MiniFifo(std::max(1, (int)std::lround(frames * fifo_rate))));
+}
+
+uint64_t ShardsProfiler::make_key(int pid, int page_id)
+{
+    return ((uint64_t)(uint32_t)pid << 32) | (uint32_t)page_id;
+}
+
+uint32_t ShardsProfiler::hash_of(uint64_t key)
+{
+    /* 64-bit finalizer from MurmurHash3, reduced to HASH_BITS_ bits */
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ULL;
+    key ^= key >> 33;
+    return (uint32_t)(key & ((1u << HASH_BITS_) - 1));
+}
+
+double ShardsProfiler::rate() const
+{
+    return threshold_ / (double)(1u << HASH_BITS_);
+}
+
+void ShardsProfiler::reference_by_virtual_addr(int viraddr, int pid, int time_accessed)
+{
+    record(pid, viraddr / PAGE_SIZE_);
+
+    if (downstream_)
+        downstream_->reference_by_virtual_addr(viraddr, pid, time_accessed);
+}
+
+void ShardsProfiler::context_switch(int from_pid, int to_pid)
+{
+    if (downstream_)
+        downstream_->context_switch(from_pid, to_pid);
+}
+
+void ShardsProfiler::record(int pid, int page_id)
+{
+    reference_count_++;
+
+    uint64_t key = make_key(pid, page_id);
+    uint32_t hash = hash_of(key);
+
+    if (hash < threshold_)
+        record_lru(key, hash);
+
+    if (hash < FIFO_THRESHOLD_)
+    {
+        fifo_sampled_count_++;
+
+        for (auto &fifo : fifos_)
+            fifo.reference(key);
+    }
+}
+
+void ShardsProfiler::record_lru(uint64_t key, uint32_t hash)
+{
+    if (clock_ == tree_.size())
+        compact();
+
+    clock_++;
+
+    double weight = 1.0 / rate();
+    auto sample = samples_.find(key);
+
+    total_weight_ += weight;
+
+    if (sample == samples_.end())
+    {
+        cold_weight_ += weight;
+
+        Sample fresh = {clock_, hash};
+        samples_.insert(std::make_pair(key, fresh));
+        by_hash_.push(std::make_pair(hash, key));
+        tree_.mark(clock_);
+
+        if ((int)samples_.size() > MAX_SAMPLES_)
+            lower_threshold();
+
+        return;
+    }
+
+    /* Other sampled pages referenced since this one, scaled to the whole stream, plus the page itself */
+    int64_t others = tree_.prefix_count(clock_ - 1) - tree_.prefix_count(sample->second.last_access);
+    int64_t scaled = (int64_t)std::llround(others * weight) + 1;
+
+    scaled_distances_[scaled] += weight;
+
+    tree_.unmark(sample->second.last_access);
+    sample->second.last_access = clock_;
+    tree_.mark(clock_);
+}
+
+void ShardsProfiler::lower_threshold()
+{
+    /* Stop sampling the largest hash, and every page that has it */
+
+    threshold_ = by_hash_.top().first;
+
+    while (!by_hash_.empty() && by_hash_.top().first >= threshold_)
+    {
+        auto sample = samples_.find(by_hash_.top().second);
+
+        tree_.unmark(sample->second.last_access);
+        samples_.erase(sample);
+        by_hash_.pop();
+    }
+}
+
+void ShardsProfiler::compact()
+{
+    /**
+     * Reference times only matter by their order: renumber the sampled
+     * pages' latest times 1..n and rebuild the tree, so it never outgrows
+     * a few times the sample limit.
+     */
+
+    std::vector<std::pair<int64_t, Sample *>> order;
+
+    for (auto &sample : samples_)
+        order.push_back(std::make_pair(sample.second.last_access, &sample.second));
+
+    std::sort(order.begin(), order.end());
+
+    tree_ = FenwickTree(tree_.size());
+    clock_ = 0;
+
+    for (auto &entry : order)
+    {
+        entry.second->last_access = ++clock_;
+        tree_.mark(clock_);
+    }
+}
+
+void ShardsProfiler::MiniFifo::reference(uint64_t key)
+{
+    if (resident.count(key))
+        return;
+
+    faults++;
+
+    if (ring.size() < capacity)
+    {
+        ring.push_back(key);
+    }
+    else
+    {
+        resident.erase(ring[head]);
+        ring[head] = key;
+        head = (head + 1) % ring.size();
+    }
+
+    resident.insert(key);
+}
+
+int64_t ShardsProfiler::reference_count() const { return reference_count_; }
+
+const std::vector<int> &ShardsProfiler::frame_counts() const { return frame_counts_; }
+
+double ShardsProfiler::lru_faults(int point) const
+{
+    double faults = cold_weight_;
+
+    for (auto it = scaled_distances_.upper_bound(frame_counts_[point]); it != scaled_distances_.end(); ++it)
+        faults += it->second;
+
+    if (total_weight_ == 0)
+        return 0;
+
+    return faults / total_weight_ * reference_count_;
+}
+
+double ShardsProfiler::fifo_faults(int point) const
+{
+    if (fifo_sampled_count_ == 0)
+        return 0;
+
+    return fifos_[point].faults / (double)fifo_sampled_count_ * reference_count_;
+}
+
+void ShardsProfiler::print_miss_ratio_curves(std::ostream &stream) const
+{
+    stream << "\nSampled LRU and FIFO miss ratio curves over " << reference_count_ << " references "
+           << "(LRU sampling rate " << rate() << " over at most " << MAX_SAMPLES_ << " pages, "
+           << "FIFO sampling rate " << FIFO_THRESHOLD_ / (double)(1u << HASH_BITS_) << "):\n"
+           << "frames\tLRU faults\tLRU miss ratio\tFIFO faults\tFIFO miss ratio\n";
+
+    for (size_t i = 0; i < frame_counts_.size(); i++)
+    {
+        double lru = lru_faults((int)i);
+        double fifo = fifo_faults((int)i);
+        double n = reference_count_ > 0 ? (double)reference_count_ : 1.0;
+
+        stream << frame_counts_[i] << "\t" << std::llround(lru) << "\t" << lru / n
+               << "\t" << std::llround(fifo) << "\t" << fifo / n << "\n";
+    }
+
+    stream << std::flush;
+}
+} // namespace mrc
@@ -0,0 +1,109 @@
+#ifndef H_SHARDSPROFILER
+#define H_SHARDSPROFILER
+
+#include <cstdint>
+#include <iosfwd>
+#include <map>
+#include <queue>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "fenwick.h"
+#include "../pager/refsink.h"
+
+namespace mrc
+{
+/**
+ * Approximate LRU and FIFO miss ratio curves by spatially hashed sampling
+ * (SHARDS, Waldspurger et al.). A page is sampled when the hash of its
+ * (pid, page) key falls under a threshold, so either every reference to a
+ * page is seen or none is, and the sampled stream behaves like the whole
+ * stream shrunk by the sampling rate R.
+ *
+ * LRU: stack distances of the sampled references are computed as in
+ * StackProfiler and scaled by 1/R; fault counts are normalized by the
+ * sampled references' total weight, which corrects for the sample holding
+ * more or fewer references than its share (SHARDS-adj). At most max_samples distinct pages are
+ * tracked; beyond that the threshold is lowered to drop the pages with the
+ * largest hashes, so memory stays bounded however long the stream is.
+ *
+ * FIFO has no stack property, so every requested frame count F gets a
+ * miniature FIFO simulation of R * F frames over the sampled references
+ * (at the initial rate), whose miss ratio estimates that of F frames.
+ *
+ * References are forwarded unchanged to the downstream sink, if any.
+ */
+class ShardsProfiler : public pager::ReferenceSink
+{
+public:
+    ShardsProfiler(int page_size, double rate, int max_samples,
+                   const std::vector<int> &frame_counts, pager::ReferenceSink *downstream);
+
+    void reference_by_virtual_addr(int viraddr, int pid, int time_accessed) override;
+    void context_switch(int from_pid, int to_pid) override;
+    void record(int pid, int page_id);
+
+    int64_t reference_count() const;
+    const std::vector<int> &frame_counts() const;
+
+    /* Estimated faults with frame_counts()[point] frames */
+    double lru_faults(int point) const;
+    double fifo_faults(int point) const;
+
+    void print_miss_ratio_curves(std::ostream &stream) const;
+
+private:
+    struct Sample
+    {
+        int64_t last_access;
+        uint32_t hash;
+    };
+
+    /* FIFO over a fixed number of frames, for one point of the FIFO curve */
+    struct MiniFifo
+    {
+        size_t capacity;
+        std::vector<uint64_t> ring;
+        size_t head;
+        std::unordered_set<uint64_t> resident;
+        int64_t faults;
+
+        MiniFifo(int capacity) : capacity(capacity), head(0), faults(0) {}
+        void reference(uint64_t key);
+    };
+
+    static uint64_t make_key(int pid, int page_id);
+    static uint32_t hash_of(uint64_t key);
+
+    double rate() const;
+    void record_lru(uint64_t key, uint32_t hash);
+    void lower_threshold();
+    void compact();
+
+    static const int HASH_BITS_;
+
+    const int PAGE_SIZE_;
+    const int MAX_SAMPLES_;
+    const uint32_t FIFO_THRESHOLD_;
+    pager::ReferenceSink *downstream_;
+
+    int64_t reference_count_;
+    int64_t fifo_sampled_count_;
+
+    /* LRU: sampled pages, their reference times in a Fenwick tree, and the weighted distance histogram */
+    uint32_t threshold_;
+    FenwickTree tree_;
+    int64_t clock_;
+    std::unordered_map<uint64_t, Sample> samples_;
+    std::priority_queue<std::pair<uint32_t, uint64_t>> by_hash_;
+    std::map<int64_t, double> scaled_distances_;
+    double cold_weight_;
+    double total_weight_;
+
+    std::vector<int> frame_counts_;
+    std::vector<MiniFifo> fifos_;
+};
+} // namespace mrc
+
+#endif
@@ -0,0 +1,126 @@
+#include "shardsreport.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <sstream>
+
+#include "shardsprofiler.h"
+#include "../io/randintreader.h"
+#include "../io/randsource.h"
+#include "../io/uin.h"
+#include "../pager/pager.h"
+#include "../pager/pagerfactory.h"
+#include "../trace/tracebuffer.h"
+
+namespace mrc
+{
+
+namespace
+{
+
+const int DEFAULT_POINTS_ = 16;
+
+int64_t exact_faults(const io::UserInput &uin, pager::AlgoName algoname, int frames,
+                     const trace::TraceBuffer &stream)
+{
+    io::UserInput config = uin;
+    config.machine_size = frames * uin.page_size;
+    config.algoname = algoname;
+    config.debug = false;
+    config.histograms = false;
+
+    io::RandIntReader unused(std::unique_ptr<io::RandomSource>(new io::CounterRandomSource(0, 0)), false);
+    std::unique_ptr<pager::PagerBase> pager = pager::make_pager(config, unused);
+
+    stream.replay(*pager);
+
+    int64_t faults = 0;
+
+    for (auto &pstat : pager->process_stats())
+        faults += pstat.second.page_fault_count;
+
+    return faults;
+}
+
+} // namespace
+
+std::vector<int> curve_frame_counts(const io::UserInput &uin)
+{
+    std::vector<int> counts;
+
+    if (uin.mrc_frames.empty())
+    {
+        int limit = 2 * std::max(1, uin.machine_size / uin.page_size);
+        int step = std::max(1, limit / DEFAULT_POINTS_);
+
+        for (int frames = step; frames <= limit; frames += step)
+            counts.push_back(frames);
+
+        return counts;
+    }
+
+    std::istringstream values(uin.mrc_frames);
+    std::string value;
+
+    while (std::getline(values, value, ','))
+    {
+        int first = 0, last = 0, step = 1;
+        char colon;
+        std::istringstream range(value);
+
+        range >> first;
+        last = first;
+
+        if (range >> colon >> last)
+            range >> colon >> step;
+
+        if (first < 1 || last < first || step < 1)
+        {
+            std::cout << "The miss ratio curve frame counts are not correct. Terminating..." << std::endl;
+            exit(10);
+        }
+
+        for (int frames = first; frames <= last; frames += step)
+            counts.push_back(frames);
+    }
+
+    return counts;
+}
+
+void print_shards_validation(const ShardsProfiler &profiler, const trace::TraceBuffer &stream,
+                             const io::UserInput &uin, std::ostream &out)
+{
+    const std::vector<int> &frame_counts = profiler.frame_counts();
+    double n = profiler.reference_count() > 0 ? (double)profiler.reference_count() : 1.0;
+
+    double lru_error = 0;
+    double fifo_error = 0;
+
+    out << "\nSampled curves against exact pagers:\n"
+        << "frames\tLRU exact\tLRU sampled\tFIFO exact\tFIFO sampled\n";
+
+    for (size_t i = 0; i < frame_counts.size(); i++)
+    {
+        int64_t lru = exact_faults(uin, pager::LRU, frame_counts[i], stream);
+        int64_t fifo = exact_faults(uin, pager::FIFO, frame_counts[i], stream);
+        double lru_sampled = profiler.lru_faults((int)i);
+        double fifo_sampled = profiler.fifo_faults((int)i);
+
+        lru_error += std::fabs(lru - lru_sampled) / n;
+        fifo_error += std::fabs(fifo - fifo_sampled) / n;
+
+        out << frame_counts[i] << "\t" << lru << "\t" << std::llround(lru_sampled)
+            << "\t" << fifo << "\t" << std::llround(fifo_sampled) << "\n";
+    }
+
+    if (!frame_counts.empty())
+    {
+        out << "Mean absolute miss ratio error: LRU " << lru_error / frame_counts.size()
+            << ", FIFO " << fifo_error / frame_counts.size() << "\n";
+    }
+
+    out << std::flush;
+}
+} // namespace mrc
@@ -0,0 +1,37 @@
+#ifndef H_SHARDSREPORT
+#define H_SHARDSREPORT
+
+#include <iosfwd>
+#include <vector>
+
+namespace io
+{
+struct UserInput;
+}
+
+namespace trace
+{
+class TraceBuffer;
+}
+
+namespace mrc
+{
+class ShardsProfiler;
+
+/**
+ * Frame counts of the sampled curves: uin.mrc_frames, a comma separated list
+ * of counts or `first:last[:step]` ranges, or by default 16 evenly spaced
+ * points up to twice the frame count of uin.
+ */
+std::vector<int> curve_frame_counts(const io::UserInput &uin);
+
+/**
+ * Replays the recorded reference stream against exact LRU and FIFO pagers at
+ * every frame count of the sampled curves, and prints the exact and sampled
+ * fault counts side by side with the mean absolute error of the miss ratio.
+ */
+void print_shards_validation(const ShardsProfiler &profiler, const trace::TraceBuffer &stream,
+                             const io::UserInput &uin, std::ostream &out);
+} // namespace mrc
+
+#endif
@@ -0,0 +1,151 @@
+#include "stackprofiler.h"
+
+#include <iostream>
+
+namespace mrc
+{
+StackProfiler::StackProfiler(int page_size, pager::ReferenceSink *downstream)
+    : PAGE_SIZE_(page_size), downstream_(downstream), tree_(1024), clock_(0), max_distance_(0) {}
+
+uint64_t StackProfiler::make_key(int pid, int page_id)
+{
+    return ((uint64_t)(uint32_t)pid << 32) | (uint32_t)page_id;
+}
+
+void StackProfiler::reference_by_virtual_addr(int viraddr, int pid, int time_accessed)
+{
+    record(pid, viraddr / PAGE_SIZE_);
+
+    if (downstream_)
+        downstream_->reference_by_virtual_addr(viraddr, pid, time_accessed);
+}
+
+void StackProfiler::context_switch(int from_pid, int to_pid)
+{
+    if (downstream_)
+        downstream_->context_switch(from_pid, to_pid);
+}
+
+void StackProfiler::record(int pid, int page_id)
+{
+    clock_++;
+
+    if (clock_ > tree_.size())
+        tree_.grow();
+
+    ProcessDistances &distances = processes_[pid];
+    distances.reference_count++;
+
+    auto last = last_access_.find(make_key(pid, page_id));
+
+    if (last == last_access_.end())
+    {
+        distances.cold_count++;
+        last_access_.insert(std::make_pair(make_key(pid, page_id), clock_));
+    }
+    else
+    {
+        /* Pages whose latest reference lies after this page's previous one */
+        int64_t distance = tree_.prefix_count(clock_ - 1) - tree_.prefix_count(last->second) + 1;
+
+        if ((int64_t)distances.histogram.size() <= distance)
+            distances.histogram.resize(distance + 1, 0);
+
+        distances.histogram[distance]++;
+
+        if (distance > max_distance_)
+            max_distance_ = distance;
+
+        tree_.unmark(last->second);
+        last->second = clock_;
+    }
+
+    tree_.mark(clock_);
+}
+
+int64_t StackProfiler::faults(const ProcessDistances &distances, int64_t frame_count)
+{
+    int64_t count = distances.cold_count;
+
+    for (int64_t d = frame_count + 1; d < (int64_t)distances.histogram.size(); d++)
+        count += distances.histogram[d];
+
+    return count;
+}
+
+int64_t StackProfiler::reference_count() const { return clock_; }
+
+int64_t StackProfiler::max_distance() const { return max_distance_; }
+
+int64_t StackProfiler::faults(int64_t frame_count) const
+{
+    int64_t count = 0;
+
+    for (auto &process : processes_)
+        count += faults(process.second, frame_count);
+
+    return count;
+}
+
+int64_t StackProfiler::faults(int pid, int64_t frame_count) const
+{
+    auto process = processes_.find(pid);
+
+    if (process == processes_.end())
+        return 0;
+
+    return faults(process->second, frame_count);
+}
+
+void StackProfiler::print_miss_ratio_curve(std::ostream &stream) const
+{
+    /**
+     * Fault counts are accumulated from the largest distance downwards, so
+     * the whole curve costs one pass over the histograms.
+     */
+
+    std::map<int, std::vector<int64_t>> curves;
+
+    for (auto &process : processes_)
+    {
+        std::vector<int64_t> &curve = curves[process.first];
+        curve.assign(max_distance_ + 1, 0);
+
+        int64_t count = process.second.cold_count;
+
+        for (int64_t f = max_distance_; f >= 1; f--)
+        {
+            if (f + 1 < (int64_t)process.second.histogram.size())
+                count += process.second.histogram[f + 1];
+
+            curve[f] = count;
+        }
+    }
+
+    stream << "\nLRU miss ratio curve over " << clock_ << " references "
+           << "(frames beyond " << max_distance_ << " fault only on first use):\n"
+           << "frames\tfaults\tmiss ratio";
+
+    for (auto &process : processes_)
+        stream << "\tprocess " << process.first;
+
+    stream << "\n";
+
+    for (int64_t f = 1; f <= max_distance_; f++)
+    {
+        int64_t total = 0;
+
+        for (auto &curve : curves)
+            total += curve.second[f];
+
+        stream << f << "\t" << total << "\t" << (clock_ > 0 ? total / (double)clock_ : 0.0);
+
+        for (auto &curve : curves)
+            stream << "\t" << curve.second[f];
+
+        stream << "\n";
+    }
+
+    stream << std::flush;
+}
+} // namespace mrc
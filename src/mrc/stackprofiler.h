@@ -0,0 +1,69 @@
+#ifndef H_STACKPROFILER
+#define H_STACKPROFILER
+
+#include <cstdint>
+#include <iosfwd>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+#include "fenwick.h"
+#include "../pager/refsink.h"
+
+namespace mrc
+{
+/**
+ * Single-pass Mattson stack simulation of LRU. For every reference it finds
+ * the LRU stack distance of the page (the number of distinct pages referenced
+ * since its previous reference, itself included) by counting, in a Fenwick
+ * tree over reference times, the pages whose latest reference lies in between.
+ *
+ * By the stack inclusion property, an LRU pager with F frames faults exactly
+ * on the cold references and on those with distance greater than F, so one
+ * pass yields the fault count of every frame count, overall and per process.
+ *
+ * References are forwarded unchanged to the downstream sink, if any.
+ */
+class StackProfiler : public pager::ReferenceSink
+{
+public:
+    StackProfiler(int page_size, pager::ReferenceSink *downstream);
+
+    void reference_by_virtual_addr(int viraddr, int pid, int time_accessed) override;
+    void context_switch(int from_pid, int to_pid) override;
+    void record(int pid, int page_id);
+
+    int64_t reference_count() const;
+    int64_t faults(int64_t frame_count) const;
+    int64_t faults(int pid, int64_t frame_count) const;
+
+    /* Largest finite stack distance seen; more frames never fault less. */
+    int64_t max_distance() const;
+
+    void print_miss_ratio_curve(std::ostream &stream) const;
+
+private:
+    struct ProcessDistances
+    {
+        std::vector<int64_t> histogram; /* histogram[d]: references at distance d */
+        int64_t cold_count;
+        int64_t reference_count;
+
+        ProcessDistances() : cold_count(0), reference_count(0) {}
+    };
+
+    static uint64_t make_key(int pid, int page_id);
+    static int64_t faults(const ProcessDistances &distances, int64_t frame_count);
+
+    const int PAGE_SIZE_;
+    pager::ReferenceSink *downstream_;
+
+    FenwickTree tree_;
+    int64_t clock_;
+    int64_t max_distance_;
+    std::unordered_map<uint64_t, int64_t> last_access_;
+    std::map<int, ProcessDistances> processes_;
+};
+} // namespace mrc
+
+#endif
@@ -0,0 +1,150 @@
+#include "costmodel.h"
+
+#include <iostream>
+
+namespace pager
+{
+CostModel::CostModel(const CostConfig &config)
+    : CONFIG_(config), LAST_TIER_((int)config.tiers.size() - 1), demotions_(0)
+{
+    /* Unlimited or very large tiers start small; their lists grow as pages are written back */
+    for (auto &tier : config.tiers)
+    {
+        int64_t capacity = (tier.capacity > 0 && tier.capacity < (1 << 20)) ? tier.capacity + 1 : 1024;
+        tiers_.push_back(GhostList((int)capacity));
+    }
+}
+
+CostModel::ProcessCosts &CostModel::costs_of(int pid)
+{
+    if ((int)processes_.size() <= pid)
+    {
+        ProcessCosts empty = {0, 0, 0, 0, std::vector<int64_t>(CONFIG_.tiers.size(), 0)};
+        processes_.resize(pid + 1, empty);
+    }
+
+    return processes_[pid];
+}
+
+int CostModel::tier_of(uint64_t key) const
+{
+    for (int tier = 0; tier < LAST_TIER_; tier++)
+    {
+        if (tiers_[tier].contains(key))
+            return tier;
+    }
+
+    return LAST_TIER_;
+}
+
+void CostModel::on_reference(int pid, uint64_t key, bool is_fault)
+{
+    ProcessCosts &costs = costs_of(pid);
+
+    costs.references++;
+    costs.cycles += CONFIG_.access_cycles;
+
+    if (is_fault)
+    {
+        int tier = tier_of(key);
+
+        costs.reads[tier]++;
+        costs.cycles += CONFIG_.fault_cycles + CONFIG_.tiers[tier].latency;
+    }
+}
+
+void CostModel::on_eviction(int pid, uint64_t key, bool is_dirty)
+{
+    ProcessCosts &costs = costs_of(pid);
+
+    costs.evictions++;
+    costs.cycles += CONFIG_.eviction_cycles;
+
+    if (is_dirty)
+    {
+        costs.write_backs++;
+        costs.cycles += CONFIG_.tiers[0].latency;
+        write_back(key);
+    }
+}
+
+void CostModel::write_back(uint64_t key)
+{
+    /* The new copy goes to the fastest tier; any older copy is dropped */
+
+    for (int tier = 0; tier < LAST_TIER_; tier++)
+        tiers_[tier].remove(key);
+
+    if (LAST_TIER_ == 0)
+        return;
+
+    tiers_[0].push_front(key);
+
+    for (int tier = 0; tier < LAST_TIER_; tier++)
+    {
+        int64_t capacity = CONFIG_.tiers[tier].capacity;
+
+        if (capacity == 0 || tiers_[tier].size() <= capacity)
+            break;
+
+        uint64_t demoted = tiers_[tier].pop_back();
+        demotions_++;
+
+        if (tier + 1 < LAST_TIER_)
+            tiers_[tier + 1].push_front(demoted);
+    }
+}
+
+double CostModel::effective_access_time(int pid) const
+{
+    int64_t references = 0;
+    int64_t cycles = 0;
+
+    for (size_t p = 0; p < processes_.size(); p++)
+    {
+        if (pid < 0 || (int)p == pid)
+        {
+            references += processes_[p].references;
+            cycles += processes_[p].cycles;
+        }
+    }
+
+    return references > 0 ? cycles / (double)references : 0.0;
+}
+
+void CostModel::print_costs(std::ostream &stream) const
+{
+    stream << "\nEffective access time (" << CONFIG_.access_cycles << " cycles per access, "
+           << CONFIG_.fault_cycles << " per fault, " << CONFIG_.eviction_cycles << " per eviction; tiers";
+
+    for (auto &tier : CONFIG_.tiers)
+    {
+        stream << " " << tier.name << " " << tier.latency << " cycles";
+
+        if (tier.capacity > 0 && &tier != &CONFIG_.tiers.back())
+            stream << " for " << tier.capacity << " pages";
+    }
+
+    stream << "):" << std::endl;
+
+    for (size_t pid = 0; pid < processes_.size(); pid++)
+    {
+        const ProcessCosts &costs = processes_[pid];
+
+        if (costs.references == 0)
+            continue;
+
+        stream << "Process " << pid << " had an effective access time of "
+               << costs.cycles / (double)costs.references << " cycles (faults served by";
+
+        for (size_t tier = 0; tier < CONFIG_.tiers.size(); tier++)
+            stream << " " << CONFIG_.tiers[tier].name << " " << costs.reads[tier];
+
+        stream << "; " << costs.evictions << " evictions, " << costs.write_backs << " write-backs)."
+               << std::endl;
+    }
+
+    stream << "The overall effective access time is " << effective_access_time(-1) << " cycles ("
+           << demotions_ << " pages demoted between tiers)." << std::endl;
+}
+} // namespace pager
@@ -0,0 +1,82 @@
+#ifndef H_COSTMODEL
+#define H_COSTMODEL
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include "ghostlist.h"
+
+namespace pager
+{
+/* One level of the backing store, fastest first. */
+struct BackingTier
+{
+    std::string name;
+    int64_t latency;  /* cycles to read or write one page */
+    int64_t capacity; /* pages; 0 for unlimited (the last tier always is) */
+};
+
+struct CostConfig
+{
+    bool enabled;
+    int64_t access_cycles;   /* every reference: the memory access itself */
+    int64_t fault_cycles;    /* every fault: trap and handler, on top of the tier read */
+    int64_t eviction_cycles; /* every eviction: unmapping the victim, on top of any write-back */
+    std::vector<BackingTier> tiers;
+
+    CostConfig() : enabled(false), access_cycles(100), fault_cycles(5000), eviction_cycles(2000)
+    {
+        BackingTier ssd = {"ssd", 100000, 0};
+        tiers.push_back(ssd);
+    }
+};
+
+/**
+ * Effective access time model. Every reference costs access_cycles; a fault
+ * adds fault_cycles plus the latency of the tier its page is read from, and an
+ * eviction adds eviction_cycles plus, for a dirty page, a write-back to the
+ * fastest tier. Tiers are exclusive and LRU-ordered: a full tier demotes its
+ * least recently written page to the next one. A page never written back is
+ * read from the last tier, where the process image lives; a clean page keeps
+ * its copy, so evicting it again costs no write-back. Costs are charged to the
+ * process whose reference caused them.
+ */
+class CostModel
+{
+public:
+    CostModel(const CostConfig &config);
+
+    void on_reference(int pid, uint64_t key, bool is_fault);
+    void on_eviction(int pid, uint64_t key, bool is_dirty);
+
+    /* Average cycles per reference of pid, or of every process for pid < 0 */
+    double effective_access_time(int pid) const;
+
+    void print_costs(std::ostream &stream) const;
+
+private:
+    struct ProcessCosts
+    {
+        int64_t references;
+        int64_t cycles;
+        int64_t evictions;
+        int64_t write_backs;
+        std::vector<int64_t> reads; /* faults served by each tier */
+    };
+
+    ProcessCosts &costs_of(int pid);
+    int tier_of(uint64_t key) const;
+    void write_back(uint64_t key);
+
+    const CostConfig CONFIG_;
+    const int LAST_TIER_;
+
+    std::vector<GhostList> tiers_;
+    std::vector<ProcessCosts> processes_; /* indexed by pid */
+    int64_t demotions_;
+};
+} // namespace pager
+
+#endif
@@ -0,0 +1,15 @@
+#ifndef H_EVICTIONLISTENER
+#define H_EVICTIONLISTENER
+
+namespace pager
+{
+/* Told by a pager whenever a resident page leaves memory, e.g. to shoot down its cached translation. */
+class EvictionListener
+{
+public:
+    virtual ~EvictionListener() {}
+    virtual void on_page_evicted(int pid, int page_id) = 0;
+};
+} // namespace pager
+
+#endif
@@ -0,0 +1,26 @@
+#include "fanoutsink.h"
+
+namespace pager
+{
+void FanOutSink::add(ReferenceSink &sink)
+{
+    sinks_.push_back(&sink);
+}
+
+int FanOutSink::size() const
+{
+    return (int)sinks_.size();
+}
+
+void FanOutSink::reference_by_virtual_addr(int viraddr, int pid, int time_accessed)
+{
+    for (ReferenceSink *sink : sinks_)
+        sink->reference_by_virtual_addr(viraddr, pid, time_accessed);
+}
+
+void FanOutSink::context_switch(int from_pid, int to_pid)
+{
+    for (ReferenceSink *sink : sinks_)
+        sink->context_switch(from_pid, to_pid);
+}
+} // namespace pager
@@ -0,0 +1,29 @@
+#ifndef H_FANOUTSINK
+#define H_FANOUTSINK
+
+#include <vector>
+
+#include "refsink.h"
+
+namespace pager
+{
+/**
+ * Forwards every reference, in order, to each of a set of sinks, so several
+ * pagers can be driven in lock-step by a single generated stream. The sinks
+ * are not owned.
+ */
+class FanOutSink : public ReferenceSink
+{
+public:
+    void add(ReferenceSink &sink);
+    int size() const;
+
+    void reference_by_virtual_addr(int viraddr, int pid, int time_accessed) override;
+    void context_switch(int from_pid, int to_pid) override;
+
+private:
+    std::vector<ReferenceSink *> sinks_;
+};
+} // namespace pager
+
+#endif
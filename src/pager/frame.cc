@@ -6,10 +6,13 @@ namespace pager
 {
 const int Frame::UNDEF_ = -10;
 
-Frame::Frame() : page_id_(UNDEF_), pid_(UNDEF_), latest_access_time_(UNDEF_), time_loaded_(UNDEF_){};
+Frame::Frame()
+    : page_id_(UNDEF_), pid_(UNDEF_), latest_access_time_(UNDEF_), time_loaded_(UNDEF_),
+      referenced_(false), modified_(false), use_count_(0){};
 
 Frame::Frame(int pageid, int pid, int access_time)
-    : page_id_(pageid), pid_(pid), latest_access_time_(access_time), time_loaded_(access_time){};
+    : page_id_(pageid), pid_(pid), latest_access_time_(access_time), time_loaded_(access_time),
+      referenced_(false), modified_(false), use_count_(0){};
 
 bool Frame::is_older_than(const Frame &other) const
 {
@@ -26,16 +29,19 @@ int Frame::residency_time(int eviction_time) const
     return (eviction_time - time_loaded_);
 }
 
-Frame &Frame::operator=(Frame &rhs)
+Frame &Frame::operator=(const Frame &rhs)
 {
     page_id_ = rhs.page_id_;
     pid_ = rhs.pid_;
     latest_access_time_ = rhs.latest_access_time_;
     time_loaded_ = rhs.time_loaded_;
+    referenced_ = rhs.referenced_;
+    modified_ = rhs.modified_;
+    use_count_ = rhs.use_count_;
     return *this;
 }
 
-bool Frame::operator==(Frame &rhs)
+bool Frame::operator==(const Frame &rhs) const
 {
     return (this->page_id_ == rhs.page_id_ && this->pid_ == rhs.pid_);
 }
@@ -54,6 +60,4 @@ int Frame::page_id() const { return page_id_; }
 
 int Frame::latest_access_time() const { return latest_access_time_; }
 
-void Frame::set_latest_access_time(int t) { latest_access_time_ = t; }
-
 } // namespace pager
\ No newline at end of file
@@ -18,11 +18,19 @@ public:
     int pid() const;
     int page_id() const;
     int latest_access_time() const;
-    void set_latest_access_time(int t);
+    void set_latest_access_time(int t) { latest_access_time_ = t; }
     int residency_time(int eviction_time) const;
 
-    Frame &operator=(Frame &rhs);
-    bool operator==(Frame &rhs);
+    /* Reference bit, modify bit and use counter of the clock policies */
+    bool is_referenced() const { return referenced_; }
+    void set_referenced(bool referenced) { referenced_ = referenced; }
+    bool is_modified() const { return modified_; }
+    void set_modified(bool modified) { modified_ = modified; }
+    int use_count() const { return use_count_; }
+    void set_use_count(int count) { use_count_ = count; }
+
+    Frame &operator=(const Frame &rhs);
+    bool operator==(const Frame &rhs) const;
     friend std::ostream &operator<<(std::ostream &stream, const Frame &fr);
 
 private:
@@ -31,6 +39,9 @@ private:
     int pid_;
     int latest_access_time_;
     int time_loaded_;
+    bool referenced_;
+    bool modified_;
+    int use_count_;
 };
 } // namespace pager
 
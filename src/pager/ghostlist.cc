@@ -0,0 +1,175 @@
+#include "ghostlist.h"
+
+#include "pageindex.h"
+
+namespace pager
+{
+const int GhostList::NIL_ = -1;
+
+GhostList::GhostList(int capacity) : head_(NIL_), tail_(NIL_), free_(NIL_), size_(0)
+{
+    keys_.resize(capacity > 0 ? capacity : 1);
+    prev_.resize(keys_.size());
+    next_.resize(keys_.size());
+
+    for (int node = (int)keys_.size() - 1; node >= 0; node--)
+    {
+        next_[node] = free_;
+        free_ = node;
+    }
+
+    uint64_t table_size = 8;
+
+    while (table_size < 2 * (uint64_t)keys_.size())
+        table_size <<= 1;
+
+    slots_.assign(table_size, NIL_);
+    mask_ = table_size - 1;
+}
+
+bool GhostList::contains(uint64_t key) const { return slots_[slot_of(key)] != NIL_; }
+
+int GhostList::size() const { return size_; }
+
+bool GhostList::empty() const { return size_ == 0; }
+
+uint64_t GhostList::back() const { return keys_[tail_]; }
+
+uint64_t GhostList::slot_of(uint64_t key) const
+{
+    /* Slot holding key, or the empty slot where its probe sequence ends */
+
+    uint64_t i = PageIndex::hash(key) & mask_;
+
+    while (slots_[i] != NIL_ && keys_[slots_[i]] != key)
+        i = (i + 1) & mask_;
+
+    return i;
+}
+
+void GhostList::push_front(uint64_t key)
+{
+    uint64_t slot = slot_of(key);
+
+    if (slots_[slot] != NIL_)
+    {
+        int node = slots_[slot];
+
+        if (node != head_)
+        {
+            unlink(node);
+            link_front(node);
+        }
+
+        return;
+    }
+
+    if (free_ == NIL_)
+    {
+        grow();
+        slot = slot_of(key);
+    }
+
+    int node = free_;
+    free_ = next_[node];
+
+    keys_[node] = key;
+    slots_[slot] = node;
+    link_front(node);
+    size_++;
+}
+
+void GhostList::remove(uint64_t key)
+{
+    uint64_t slot = slot_of(key);
+    int node = slots_[slot];
+
+    if (node == NIL_)
+        return;
+
+    unlink(node);
+    erase_slot(slot);
+
+    next_[node] = free_;
+    free_ = node;
+    size_--;
+}
+
+uint64_t GhostList::pop_back()
+{
+    uint64_t key = keys_[tail_];
+    remove(key);
+    return key;
+}
+
+void GhostList::erase_slot(uint64_t slot)
+{
+    /* Backward-shift deletion, as in PageIndex::erase */
+
+    uint64_t hole = slot;
+
+    for (uint64_t j = (hole + 1) & mask_; slots_[j] != NIL_; j = (j + 1) & mask_)
+    {
+        uint64_t home = PageIndex::hash(keys_[slots_[j]]) & mask_;
+
+        bool home_between = (hole <= j) ? (hole < home && home <= j)
+                                        : (hole < home || home <= j);
+        if (!home_between)
+        {
+            slots_[hole] = slots_[j];
+            hole = j;
+        }
+    }
+
+    slots_[hole] = NIL_;
+}
+
+void GhostList::link_front(int node)
+{
+    prev_[node] = NIL_;
+    next_[node] = head_;
+
+    if (head_ != NIL_)
+        prev_[head_] = node;
+    else
+        tail_ = node;
+
+    head_ = node;
+}
+
+void GhostList::unlink(int node)
+{
+    if (prev_[node] != NIL_)
+        next_[prev_[node]] = next_[node];
+    else
+        head_ = next_[node];
+
+    if (next_[node] != NIL_)
+        prev_[next_[node]] = prev_[node];
+    else
+        tail_ = prev_[node];
+}
+
+void GhostList::grow()
+{
+    /* Only called with every node in use, so the new nodes are the free list */
+
+    int capacity = (int)keys_.size();
+
+    keys_.resize(2 * capacity);
+    prev_.resize(2 * capacity);
+    next_.resize(2 * capacity);
+
+    for (int node = 2 * capacity - 1; node >= capacity; node--)
+    {
+        next_[node] = free_;
+        free_ = node;
+    }
+
+    slots_.assign(2 * slots_.size(), NIL_);
+    mask_ = slots_.size() - 1;
+
+    for (int node = head_; node != NIL_; node = next_[node])
+        slots_[slot_of(keys_[node])] = node;
+}
+} // namespace pager
@@ -0,0 +1,55 @@
+#ifndef H_GHOSTLIST
+#define H_GHOSTLIST
+
+#include <cstdint>
+#include <vector>
+
+namespace pager
+{
+/**
+ * Recency-ordered set of page keys (front is most recent) with O(1) lookup,
+ * insertion and removal. Used for the history of pages that are no longer
+ * resident ("ghosts") and for other key-ordered queues.
+ *
+ * Keys live in a pool of nodes linked by index, as in RecencyList, and are
+ * found through an open-addressing table of node indices, as in PageIndex.
+ * Both are sized for the capacity given up front, so steady-state operations
+ * allocate nothing; a list that outgrows its capacity doubles it.
+ */
+class GhostList
+{
+public:
+    GhostList(int capacity);
+
+    bool contains(uint64_t key) const;
+    int size() const;
+    bool empty() const;
+    uint64_t back() const;
+
+    void push_front(uint64_t key);
+    void remove(uint64_t key);
+    uint64_t pop_back();
+
+private:
+    static const int NIL_;
+
+    uint64_t slot_of(uint64_t key) const;
+    void erase_slot(uint64_t slot);
+    void link_front(int node);
+    void unlink(int node);
+    void grow();
+
+    std::vector<uint64_t> keys_; /* keys_[node] */
+    std::vector<int> prev_;
+    std::vector<int> next_; /* also chains the free nodes */
+    std::vector<int> slots_; /* node holding each key, or NIL_; at most half full */
+    uint64_t mask_;
+
+    int head_;
+    int tail_;
+    int free_;
+    int size_;
+};
+} // namespace pager
+
+#endif
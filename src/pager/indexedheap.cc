@@ -0,0 +1,119 @@
+#include "indexedheap.h"
+
+namespace pager
+{
+const int IndexedHeap::ABSENT_ = -1;
+
+IndexedHeap::IndexedHeap(int capacity) : size_(0)
+{
+    heap_ = new int[capacity];
+    position_ = new int[capacity];
+    key_ = new uint64_t[capacity];
+
+    for (int i = 0; i < capacity; i++)
+        position_[i] = ABSENT_;
+}
+
+IndexedHeap::~IndexedHeap()
+{
+    delete[] heap_;
+    delete[] position_;
+    delete[] key_;
+}
+
+bool IndexedHeap::empty() const { return size_ == 0; }
+
+bool IndexedHeap::contains(int idx) const { return position_[idx] != ABSENT_; }
+
+int IndexedHeap::top() const { return heap_[0]; }
+
+bool IndexedHeap::outranks(int a, int b) const
+{
+    return key_[a] > key_[b] || (key_[a] == key_[b] && a > b);
+}
+
+void IndexedHeap::swap_nodes(int i, int j)
+{
+    int a = heap_[i];
+    int b = heap_[j];
+
+    heap_[i] = b;
+    heap_[j] = a;
+    position_[b] = i;
+    position_[a] = j;
+}
+
+void IndexedHeap::sift_up(int pos)
+{
+    while (pos > 0)
+    {
+        int parent = (pos - 1) / 2;
+
+        if (!outranks(heap_[pos], heap_[parent]))
+            break;
+
+        swap_nodes(pos, parent);
+        pos = parent;
+    }
+}
+
+void IndexedHeap::sift_down(int pos)
+{
+    while (true)
+    {
+        int left = 2 * pos + 1;
+        int right = left + 1;
+        int best = pos;
+
+        if (left < size_ && outranks(heap_[left], heap_[best]))
+            best = left;
+        if (right < size_ && outranks(heap_[right], heap_[best]))
+            best = right;
+
+        if (best == pos)
+            break;
+
+        swap_nodes(pos, best);
+        pos = best;
+    }
+}
+
+void IndexedHeap::set(int idx, uint64_t key)
+{
+    key_[idx] = key;
+
+    if (position_[idx] == ABSENT_)
+    {
+        heap_[size_] = idx;
+        position_[idx] = size_;
+        size_++;
+        sift_up(size_ - 1);
+    }
+    else
+    {
+        sift_up(position_[idx]);
+        sift_down(position_[idx]);
+    }
+}
+
+void IndexedHeap::remove(int idx)
+{
+    int pos = position_[idx];
+
+    if (pos == ABSENT_)
+        return;
+
+    size_--;
+
+    if (pos != size_)
+    {
+        swap_nodes(pos, size_);
+
+        int moved = heap_[pos];
+        sift_up(pos);
+        sift_down(position_[moved]);
+    }
+
+    position_[idx] = ABSENT_;
+}
+} // namespace pager
@@ -0,0 +1,46 @@
+#ifndef H_INDEXEDHEAP
+#define H_INDEXEDHEAP
+
+#include <cstdint>
+
+namespace pager
+{
+/**
+ * Binary max-heap over frame indices 0..capacity-1 keyed by 64-bit values.
+ * Each frame's heap position is tracked, so a frame's key can be changed or
+ * the frame removed in O(log n). Equal keys are ordered by frame index, the
+ * highest index first.
+ */
+class IndexedHeap
+{
+public:
+    IndexedHeap(int capacity);
+    ~IndexedHeap();
+
+    bool empty() const;
+    bool contains(int idx) const;
+    int top() const;
+
+    /* Inserts idx with key, or updates its key if it is already in the heap. */
+    void set(int idx, uint64_t key);
+    void remove(int idx);
+
+private:
+    IndexedHeap(const IndexedHeap &);
+    IndexedHeap &operator=(const IndexedHeap &);
+
+    bool outranks(int a, int b) const;
+    void swap_nodes(int i, int j);
+    void sift_up(int pos);
+    void sift_down(int pos);
+
+    static const int ABSENT_;
+
+    int *heap_;     /* heap_[pos]: frame index at heap position pos */
+    int *position_; /* position_[idx]: heap position of frame idx */
+    uint64_t *key_;
+    int size_;
+};
+} // namespace pager
+
+#endif
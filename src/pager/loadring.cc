@@ -0,0 +1,44 @@
+#include "loadring.h"
+
+namespace pager
+{
+LoadRing::LoadRing(int frame_count) : capacity_(frame_count), head_(0), size_(0)
+{
+    ring_ = new int[capacity_ > 0 ? capacity_ : 1];
+}
+
+LoadRing::~LoadRing()
+{
+    delete[] ring_;
+}
+
+bool LoadRing::empty() const { return size_ == 0; }
+
+int LoadRing::size() const { return size_; }
+
+int LoadRing::front() const { return ring_[head_]; }
+
+void LoadRing::push_back(int idx)
+{
+    int tail = head_ + size_;
+
+    if (tail >= capacity_)
+        tail -= capacity_;
+
+    ring_[tail] = idx;
+    size_++;
+}
+
+int LoadRing::pop_front()
+{
+    int idx = ring_[head_];
+
+    head_++;
+    if (head_ == capacity_)
+        head_ = 0;
+
+    size_--;
+    return idx;
+}
+
+} // namespace pager
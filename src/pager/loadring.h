@@ -0,0 +1,34 @@
+#ifndef H_LOADRING
+#define H_LOADRING
+
+namespace pager
+{
+/**
+ * Fixed-capacity ring of frame indices in the order their pages were loaded.
+ * The front of the ring is the frame holding the oldest page.
+ */
+class LoadRing
+{
+public:
+    LoadRing(int frame_count);
+    ~LoadRing();
+
+    bool empty() const;
+    int size() const;
+    int front() const;
+
+    void push_back(int idx);
+    int pop_front();
+
+private:
+    LoadRing(const LoadRing &);
+    LoadRing &operator=(const LoadRing &);
+
+    int *ring_;
+    int capacity_;
+    int head_;
+    int size_;
+};
+} // namespace pager
+
+#endif
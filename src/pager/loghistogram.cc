@@ -0,0 +1,74 @@
+#include "loghistogram.h"
+
+#include <cmath>
+
+namespace pager
+{
+LogHistogram::LogHistogram() : buckets_(), count_(0), sum_(0), max_(0) {}
+
+int LogHistogram::bucket_of(uint32_t value)
+{
+    if (value < (uint32_t)LINEAR_LIMIT_)
+        return (int)value;
+
+    /* value has its highest bit at position top >= 6; keep the 5 bits below it */
+    int top = 31 - __builtin_clz(value);
+    int shift = top - SUB_BUCKET_BITS_;
+    int sub_bucket = (int)(value >> shift) - SUB_BUCKETS_;
+
+    return LINEAR_LIMIT_ + (top - SUB_BUCKET_BITS_ - 1) * SUB_BUCKETS_ + sub_bucket;
+}
+
+uint32_t LogHistogram::highest_in_bucket(int bucket)
+{
+    if (bucket < LINEAR_LIMIT_)
+        return (uint32_t)bucket;
+
+    int top = (bucket - LINEAR_LIMIT_) / SUB_BUCKETS_ + SUB_BUCKET_BITS_ + 1;
+    int shift = top - SUB_BUCKET_BITS_;
+    uint64_t lead = SUB_BUCKETS_ + (bucket - LINEAR_LIMIT_) % SUB_BUCKETS_;
+
+    return (uint32_t)(((lead + 1) << shift) - 1);
+}
+
+void LogHistogram::record(uint32_t value)
+{
+    buckets_[bucket_of(value)]++;
+    count_++;
+    sum_ += value;
+
+    if (value > max_)
+        max_ = value;
+}
+
+double LogHistogram::mean() const
+{
+    return count_ ? (sum_ / (double)count_) : 0.0;
+}
+
+uint32_t LogHistogram::percentile(double percentile) const
+{
+    if (count_ == 0)
+        return 0;
+
+    uint64_t rank = (uint64_t)std::ceil(percentile / 100.0 * count_);
+
+    if (rank == 0)
+        rank = 1;
+
+    uint64_t seen = 0;
+
+    for (int bucket = 0; bucket < BUCKETS_; bucket++)
+    {
+        seen += buckets_[bucket];
+
+        if (seen >= rank)
+        {
+            uint32_t highest = highest_in_bucket(bucket);
+            return (highest < max_) ? highest : max_;
+        }
+    }
+
+    return max_;
+}
+} // namespace pager
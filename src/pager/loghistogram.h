@@ -0,0 +1,44 @@
+#ifndef H_LOGHISTOGRAM
+#define H_LOGHISTOGRAM
+
+#include <cstdint>
+
+namespace pager
+{
+/**
+ * HDR-style histogram of non-negative 32-bit values in fixed memory. Values
+ * below 64 get a bucket each; above that every power of two is split into 32
+ * sub-buckets, so a reported percentile is within about 3% of the true value.
+ * Recording is a count-leading-zeros, a shift and an increment.
+ */
+class LogHistogram
+{
+public:
+    LogHistogram();
+
+    void record(uint32_t value);
+
+    uint64_t count() const { return count_; }
+    uint32_t max() const { return max_; }
+    double mean() const;
+
+    /* Value that percentile% of the recorded values do not exceed, rounded up to its bucket (at most max()) */
+    uint32_t percentile(double percentile) const;
+
+private:
+    static const int SUB_BUCKET_BITS_ = 5;
+    static const int SUB_BUCKETS_ = 1 << SUB_BUCKET_BITS_;
+    static const int LINEAR_LIMIT_ = 2 * SUB_BUCKETS_;
+    static const int BUCKETS_ = LINEAR_LIMIT_ + (32 - SUB_BUCKET_BITS_ - 1) * SUB_BUCKETS_;
+
+    static int bucket_of(uint32_t value);
+    static uint32_t highest_in_bucket(int bucket);
+
+    uint64_t buckets_[BUCKETS_];
+    uint64_t count_;
+    uint64_t sum_;
+    uint32_t max_;
+};
+} // namespace pager
+
+#endif
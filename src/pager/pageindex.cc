@@ -0,0 +1,114 @@
+#include "pageindex.h"
+
+namespace pager
+{
+const int PageIndex::NOT_FOUND = -1;
+const int PageIndex::EMPTY_ = -1;
+
+PageIndex::PageIndex(int frame_count)
+{
+    /**
+     * Open addressing with linear probing. The table is kept at most half
+     * full so that probe sequences stay short even when every frame is in use.
+     */
+
+    uint64_t capacity = 8;
+
+    while (capacity < 2 * (uint64_t)(frame_count > 0 ? frame_count : 1))
+        capacity <<= 1;
+
+    mask_ = capacity - 1;
+    slots_ = new Slot[capacity];
+
+    for (uint64_t i = 0; i < capacity; i++)
+        slots_[i].frame_idx = EMPTY_;
+}
+
+PageIndex::~PageIndex()
+{
+    delete[] slots_;
+}
+
+uint64_t PageIndex::make_key(int pid, int page_id)
+{
+    return ((uint64_t)(uint32_t)pid << 32) | (uint32_t)page_id;
+}
+
+uint64_t PageIndex::hash(uint64_t key)
+{
+    /* 64-bit finalizer from MurmurHash3 */
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ULL;
+    key ^= key >> 33;
+    return key;
+}
+
+uint64_t PageIndex::home_of(uint64_t key) const
+{
+    return hash(key) & mask_;
+}
+
+int PageIndex::find(int pid, int page_id) const
+{
+    uint64_t key = make_key(pid, page_id);
+
+    for (uint64_t i = home_of(key);; i = (i + 1) & mask_)
+    {
+        if (slots_[i].frame_idx == EMPTY_)
+            return NOT_FOUND;
+
+        if (slots_[i].key == key)
+            return slots_[i].frame_idx;
+    }
+}
+
+void PageIndex::insert(int pid, int page_id, int frame_idx)
+{
+    uint64_t key = make_key(pid, page_id);
+    uint64_t i = home_of(key);
+
+    while (slots_[i].frame_idx != EMPTY_ && slots_[i].key != key)
+        i = (i + 1) & mask_;
+
+    slots_[i].key = key;
+    slots_[i].frame_idx = frame_idx;
+}
+
+void PageIndex::erase(int pid, int page_id)
+{
+    /**
+     * Backward-shift deletion: entries displaced past the freed slot are moved
+     * back into it, so lookups never need tombstones.
+     */
+
+    uint64_t key = make_key(pid, page_id);
+    uint64_t i = home_of(key);
+
+    while (slots_[i].frame_idx != EMPTY_ && slots_[i].key != key)
+        i = (i + 1) & mask_;
+
+    if (slots_[i].frame_idx == EMPTY_)
+        return;
+
+    uint64_t hole = i;
+
+    for (uint64_t j = (hole + 1) & mask_; slots_[j].frame_idx != EMPTY_; j = (j + 1) & mask_)
+    {
+        uint64_t home = home_of(slots_[j].key);
+
+        /* Slot j may fill the hole only if its home does not lie in (hole, j] */
+        bool home_between = (hole <= j) ? (hole < home && home <= j)
+                                        : (hole < home || home <= j);
+        if (!home_between)
+        {
+            slots_[hole] = slots_[j];
+            hole = j;
+        }
+    }
+
+    slots_[hole].frame_idx = EMPTY_;
+}
+
+} // namespace pager
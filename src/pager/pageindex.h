@@ -0,0 +1,44 @@
+#ifndef H_PAGEINDEX
+#define H_PAGEINDEX
+
+#include <cstdint>
+
+namespace pager
+{
+class PageIndex
+{
+public:
+    PageIndex(int frame_count);
+    ~PageIndex();
+
+    int find(int pid, int page_id) const;
+    void insert(int pid, int page_id, int frame_idx);
+    void erase(int pid, int page_id);
+
+    /* 64-bit finalizer from MurmurHash3; also hashes GhostList keys */
+    static uint64_t hash(uint64_t key);
+
+    static const int NOT_FOUND;
+
+private:
+    PageIndex(const PageIndex &);
+    PageIndex &operator=(const PageIndex &);
+
+    struct Slot
+    {
+        uint64_t key;
+        int frame_idx;
+    };
+
+    static uint64_t make_key(int pid, int page_id);
+
+    uint64_t home_of(uint64_t key) const;
+
+    static const int EMPTY_;
+
+    Slot *slots_;
+    uint64_t mask_;
+};
+} // namespace pager
+
+#endif
@@ -1,278 +1,355 @@
 #include "pager.h"
 #include "frame.h"
-#include "../debug.h"
+#include "policy_fifo.h"
+#include "policy_lru.h"
+#include "policy_rand.h"
+#include "policy_opt.h"
+#include "policy_clock.h"
+#include "policy_arc.h"
+#include "policy_2q.h"
+#include "policy_lirs.h"
 #include "../io/uin.h"
 #include "../io/randintreader.h"
+#include "../io/randsource.h"
+#include "../io/tracelog.h"
+#include "../driver/jobmix.h"
+#include "../driver/jobmixspec.h"
+
+#include <iomanip>
+#include <sstream>
 
 namespace pager
 {
-const int Pager::ERR_PAGE_NOT_FOUND_ = -10;
-const int Pager::WARN_FRAME_TABLE_EMPTY_ = -11;
-
-namespace dp = demandpaging;
+const int PagerBase::ERR_PAGE_NOT_FOUND_ = -10;
+const int PagerBase::ERR_NO_FREE_FRAME_ = -12;
 
-Pager::Pager(const io::UserInput &uin, io::RandIntReader &randintreader)
+PagerBase::PagerBase(const io::UserInput &uin)
     : MACHINE_SIZE_(uin.machine_size),
       PAGE_SIZE_(uin.page_size),
       FRAME_COUNT_(MACHINE_SIZE_ / PAGE_SIZE_),
-      ALGO_NAME_(uin.algoname),
-      randintreader_(randintreader)
+      DEBUG_(uin.debug),
+      HISTOGRAMS_(uin.histograms),
+      WRITE_RATIO_(uin.write_ratio),
+      PROC_SIZE_(uin.proc_size),
+      JOB_MIX_(driver::jobmixspecs::get_jobmix(uin.jobmix)),
+      page_index_(FRAME_COUNT_),
+      eviction_listener_(nullptr),
+      cost_model_(nullptr)
 {
     frame_table_ = new Frame[FRAME_COUNT_];
     next_insertion_idx_ = FRAME_COUNT_ - 1;
+
+    if (uin.cost.enabled)
+        cost_model_ = new CostModel(uin.cost);
 }
 
-Pager::~Pager()
+PagerBase::~PagerBase()
 {
-    print_process_stats_map();
     delete[] frame_table_;
+    delete cost_model_;
+}
+
+template <class Policy>
+Pager<Policy>::Pager(const io::UserInput &uin, io::RandIntReader &randintreader,
+                     const std::vector<uint64_t> *next_use)
+    : PagerBase(uin), policy_(PolicyContext(FRAME_COUNT_, frame_table_, randintreader, next_use)) {}
+
+template <class Policy>
+void Pager<Policy>::reference_by_virtual_addr(int viraddr, int pid, int time_accessed)
+{
+    if (DEBUG_)
+        reference<true>(viraddr, pid, time_accessed);
+    else
+        reference<false>(viraddr, pid, time_accessed);
+}
+
+template <class Policy>
+void Pager<Policy>::reference_batch(const int *viraddrs, int count, int pid, int first_time)
+{
+    if (DEBUG_)
+    {
+        for (int i = 0; i < count; i++)
+            reference<true>(viraddrs[i], pid, first_time + i);
+    }
+    else
+    {
+        for (int i = 0; i < count; i++)
+            reference<false>(viraddrs[i], pid, first_time + i);
+    }
 }
 
-void Pager::reference_by_virtual_addr(int viraddr, int pid, int time_accessed)
+template <class Policy>
+template <bool TRACE>
+void Pager<Policy>::reference(int viraddr, int pid, int time_accessed)
 {
     int to_visit_pageid = viraddr / PAGE_SIZE_;
 
-    if (dp::debug())
+    if (TRACE)
     {
-        std::cout << "Process " << pid
-                  << " references word " << viraddr
-                  << " (page " << to_visit_pageid << ") at time " << time_accessed << ": ";
+        io::trace_log() << "Process " << pid
+                        << " references word " << viraddr
+                        << " (page " << to_visit_pageid << ") at time " << time_accessed << ": ";
     }
 
     Frame target_frame = Frame(to_visit_pageid, pid, time_accessed);
 
     int frame_loc = search_frame(target_frame);
 
+    if (HISTOGRAMS_)
+        record_histograms(pid, to_visit_pageid, time_accessed, frame_loc == ERR_PAGE_NOT_FOUND_);
+
+    if (cost_model_)
+        cost_model_->on_reference(pid, page_key(pid, to_visit_pageid), frame_loc == ERR_PAGE_NOT_FOUND_);
+
     if (frame_loc == ERR_PAGE_NOT_FOUND_) /* Page Fault */
     {
-        if (dp::debug())
-            std::cout << "Fault, ";
+        if (TRACE)
+            io::trace_log() << "Fault, ";
 
-        bool is_insert_sucessful = insert_front(target_frame);
+        int free_frame_idx = insert_front(target_frame);
 
-        if (!is_insert_sucessful) /* No free frame(s) remaining */
+        if (free_frame_idx == ERR_NO_FREE_FRAME_) /* No free frame(s) remaining */
+        {
+            frame_loc = swap_frame<TRACE>(target_frame);
+        }
+        else
         {
-            swap_frame(target_frame);
+            if (TRACE)
+                io::trace_log() << "using free frame " << free_frame_idx;
+
+            policy_.on_fault(free_frame_idx);
+            frame_loc = free_frame_idx;
         }
     }
     else
     {
-        if (dp::debug())
-            std::cout << "Hit in frame " << frame_loc;
+        if (TRACE)
+            io::trace_log() << "Hit in frame " << frame_loc;
 
-        frame_table_[frame_loc].set_latest_access_time(time_accessed);
+        policy_.on_hit(frame_loc, time_accessed);
     }
 
-    if (dp::debug())
-        std::cout << std::endl;
+    if (WRITE_RATIO_ > 0 && is_write(pid, time_accessed))
+        frame_table_[frame_loc].set_modified(true);
+
+    if (TRACE)
+        io::trace_log() << '\n';
 }
 
-void Pager::swap_frame(Frame newframe)
+template <class Policy>
+template <bool TRACE>
+int Pager<Policy>::swap_frame(const Frame &newframe)
 {
-    if (ALGO_NAME_ == LRU)
-        lru_swap(newframe);
+    int victim_idx = policy_.select_victim(newframe);
 
-    else if (ALGO_NAME_ == FIFO)
-        fifo_swap(newframe);
+    if (TRACE)
+    {
+        const Frame &victim = frame_table_[victim_idx];
 
-    else if (ALGO_NAME_ == RANDOM)
-        random_swap(newframe);
-}
+        io::trace_log() << "evicting page " << victim.page_id()
+                        << " of process " << victim.pid() << " from frame " << victim_idx;
+    }
 
-void Pager::fifo_swap(Frame newframe)
-{
-    int i_oldest_frame = search_oldest_frame();
+    policy_.on_evict(victim_idx);
+    write_frame_at_index(victim_idx, newframe);
+    policy_.on_fault(victim_idx);
 
-    write_frame_at_index(i_oldest_frame, newframe);
+    return victim_idx;
 }
 
-void Pager::random_swap(Frame newframe)
+bool PagerBase::write_frame_at_index(int idx, const Frame &newframe)
 {
-    auto calc_evict_frame = [this](int randnum) -> int { return (randnum % FRAME_COUNT_); };
+    Frame &oldframe = frame_table_[idx];
 
-    int randnum = randintreader_.read_next_int();
+    record_process_stats_before_eviction(oldframe, newframe);
 
-    int evict_frame_idx = calc_evict_frame(randnum);
+    if (oldframe.is_initialized())
+    {
+        page_index_.erase(oldframe.pid(), oldframe.page_id());
 
-    write_frame_at_index(evict_frame_idx, newframe);
-}
+        if (eviction_listener_)
+            eviction_listener_->on_page_evicted(oldframe.pid(), oldframe.page_id());
 
-void Pager::lru_swap(Frame newframe)
-{
-    int lru_frame_idx = search_least_recently_used_frame();
+        if (cost_model_)
+            cost_model_->on_eviction(newframe.pid(), page_key(oldframe.pid(), oldframe.page_id()),
+                                     oldframe.is_modified());
+    }
+
+    frame_table_[idx] = newframe;
+    page_index_.insert(newframe.pid(), newframe.page_id(), idx);
 
-    write_frame_at_index(lru_frame_idx, newframe);
+    return true;
 }
 
-int Pager::search_least_recently_used_frame() const
+void PagerBase::record_process_stats_before_eviction(const Frame &leaving_frame,
+                                                     const Frame &incoming_frame)
 {
-    /**
-     * Locate frame with the oldest (least recent) access time. 
-     * Returns the location (index) of that frame.
-     * If the frame table is empty, a warning is raised.
-     */
+    int old_pid = leaving_frame.pid();
+    int new_pid = incoming_frame.pid();
 
-    int i_lru = FRAME_COUNT_ - 1;
+    int eviction_time = incoming_frame.latest_access_time();
+    int residency_time = leaving_frame.residency_time(eviction_time);
 
-    if (!frame_table_[i_lru].is_initialized())
+    if (leaving_frame.is_initialized())
     {
-        if (dp::debug())
-            std::cout << "WARNING: encounter empty frame table when searching LRU frame";
-
-        return WARN_FRAME_TABLE_EMPTY_;
-    }
+        process_stats_table_.record_eviction(old_pid, residency_time);
 
-    for (int i = i_lru; i >= 0; i--)
-    {
-        if (frame_table_[i].is_less_recently_used_than(frame_table_[i_lru]))
-            i_lru = i;
+        if (HISTOGRAMS_)
+            histograms_of(old_pid).residency.record(residency_time);
     }
 
-    return i_lru;
+    process_stats_table_.record_fault(new_pid);
 }
 
-int Pager::search_oldest_frame() const
+int PagerBase::search_frame(const Frame &target) const
 {
-    int i_oldest = FRAME_COUNT_ - 1;
-
-    if (!frame_table_[i_oldest].is_initialized())
-    {
-        if (dp::debug())
-            std::cout << "WARNING: encounter empty frame table when searching LRU frame";
+    /**
+     * Attempts to find a frame by process ID and page ID through the page index.
+     * Returns the frame's location if found; PageNotFound error if not found.
+     */
 
-        return WARN_FRAME_TABLE_EMPTY_;
-    }
+    int frame_loc = page_index_.find(target.pid(), target.page_id());
 
-    for (int i = i_oldest; i >= 0; i--)
-    {
-        if (frame_table_[i].is_older_than(frame_table_[i_oldest]))
-            i_oldest = i;
-    }
+    if (frame_loc == PageIndex::NOT_FOUND)
+        return ERR_PAGE_NOT_FOUND_;
 
-    return i_oldest;
+    return frame_loc;
 }
 
-bool Pager::write_frame_at_index(int idx, Frame newframe)
+void PagerBase::record_histograms(int pid, int page_id, int time_accessed, bool is_fault)
 {
-    Frame &oldframe = frame_table_[idx];
-
-    record_process_stats_before_eviction(oldframe, newframe);
+    ProcessHistograms &histograms = histograms_of(pid);
 
-    if (dp::debug())
+    if (is_fault)
     {
-        std::cout << "evicting page " << oldframe.page_id()
-                  << " of process " << oldframe.pid() << " from frame " << idx;
+        if (histograms.last_fault_time > 0)
+            histograms.inter_fault.record(time_accessed - histograms.last_fault_time);
+
+        histograms.last_fault_time = time_accessed;
     }
 
-    frame_table_[idx] = newframe;
+    /* Only a trace recorded with larger processes can reference a page past the end */
+    if ((unsigned)page_id >= histograms.last_use.size())
+        return;
 
-    return true;
-}
+    int &last_use = histograms.last_use[page_id];
 
-void Pager::record_process_stats_before_eviction(const Frame &leaving_frame,
-                                                 const Frame &incoming_frame)
-{
-    int old_pid = leaving_frame.pid();
-    int new_pid = incoming_frame.pid();
+    if (last_use > 0)
+        histograms.reuse.record(time_accessed - last_use);
 
-    int eviction_time = incoming_frame.latest_access_time();
-    int residency_time = leaving_frame.residency_time(eviction_time);
-
-    auto outgoing_process_stats = process_stats_map_.find(old_pid);
-
-    if (outgoing_process_stats == process_stats_map_.end())
-    {
-        ProcessStats ps = ProcessStats(residency_time);
-        ps.incr_eviction_count();
-        process_stats_map_.insert(std::pair<int, ProcessStats>(old_pid, ps));
-    }
-    else
-    {
-        outgoing_process_stats->second.sum_residency_time += residency_time;
-        outgoing_process_stats->second.incr_eviction_count();
-    }
+    last_use = time_accessed;
+}
 
-    auto incoming_process_stats = process_stats_map_.find(new_pid);
+ProcessHistograms &PagerBase::histograms_of(int pid)
+{
+    if ((unsigned)pid < process_histograms_.size() && process_histograms_[pid])
+        return *process_histograms_[pid];
 
-    if (incoming_process_stats == process_stats_map_.end())
-    {
-        ProcessStats ps = ProcessStats();
-        ps.incr_page_fault_count();
-        process_stats_map_.insert(std::pair<int, ProcessStats>(new_pid, ps));
-    }
-    else
-    {
-        incoming_process_stats->second.incr_page_fault_count();
-    }
+    return add_histograms(pid);
 }
 
-int Pager::search_frame(Frame target) const
+ProcessHistograms &PagerBase::add_histograms(int pid)
 {
     /**
-     * Attempts to find a frame by process ID and page ID. 
-     * Returns the frame's location if found; PageNotFound error if not found.
+     * Histograms have a fixed size, and the reuse times need one slot per
+     * page of the process, so a process costs the same from its first
+     * reference to its last.
      */
 
-    for (int i = 0; i < FRAME_COUNT_; i++)
+    if (pid < 0 || pid >= ProcessStatsTable::MAX_PID)
     {
-        if (frame_table_[i] == target)
-            return i;
+        std::cout << "Process id " << pid << " is out of range of the histograms. Terminating..." << std::endl;
+        exit(10);
     }
 
-    return ERR_PAGE_NOT_FOUND_;
+    if ((int)process_histograms_.size() <= pid)
+        process_histograms_.resize(pid + 1);
+
+    int size = PROC_SIZE_;
+
+    if (JOB_MIX_ && pid >= 1 && pid <= JOB_MIX_->process_count())
+        size = JOB_MIX_->process_size(pid, PROC_SIZE_);
+
+    int page_count = size > 0 ? (size + PAGE_SIZE_ - 1) / PAGE_SIZE_ : 0;
+
+    process_histograms_[pid].reset(new ProcessHistograms(page_count));
+    return *process_histograms_[pid];
 }
 
-bool Pager::can_insert() const
+bool PagerBase::can_insert() const
 {
     return next_insertion_idx_ >= 0;
 }
 
-bool Pager::insert_front(Frame frame)
+int PagerBase::insert_front(const Frame &frame)
 {
+    /**
+     * Loads the frame into the highest free frame slot.
+     * Returns the slot used; NoFreeFrame error if the frame table is full.
+     */
+
     if (!can_insert())
     {
-        return false;
+        return ERR_NO_FREE_FRAME_;
     }
     else
     {
-        if (dp::debug())
-            std::cout << "using free frame " << next_insertion_idx_;
-
         init_process_stats(frame);
 
-        frame_table_[next_insertion_idx_] = frame;
+        int idx = next_insertion_idx_;
+
+        frame_table_[idx] = frame;
+        page_index_.insert(frame.pid(), frame.page_id(), idx);
         next_insertion_idx_--;
 
-        return true;
+        return idx;
     }
 }
 
-void Pager::init_process_stats(const Frame &frame)
+void PagerBase::init_process_stats(const Frame &frame)
 {
-    int target_pid = frame.pid();
+    process_stats_table_.record_fault(frame.pid());
+}
 
-    auto process_stats = process_stats_map_.find(target_pid);
+void PagerBase::set_eviction_listener(EvictionListener *listener)
+{
+    eviction_listener_ = listener;
+}
 
-    if (process_stats == process_stats_map_.end())
-    {
-        ProcessStats ps = ProcessStats();
-        ps.incr_page_fault_count();
-        process_stats_map_.insert(std::pair<int, ProcessStats>(target_pid, ps));
-    }
-    else
-    {
-        process_stats->second.incr_page_fault_count();
-    }
+const CostModel *PagerBase::cost_model() const
+{
+    return cost_model_;
 }
 
-void Pager::print_process_stats_map() const
+bool PagerBase::is_write(int pid, int time_accessed) const
 {
+    /**
+     * Hashed rather than drawn from a random stream, so that enabling writes
+     * leaves every other random decision of the run unchanged.
+     */
+
+    uint64_t hash = io::CounterRandomSource::mix(((uint64_t)pid << 32) ^ (uint32_t)time_accessed);
+
+    return (hash >> 11) / 9007199254740992.0 < WRITE_RATIO_; /* top 53 bits, in [0, 1) */
+}
+
+std::map<pid, ProcessStats> PagerBase::process_stats() const
+{
+    return process_stats_table_.snapshot();
+}
+
+void PagerBase::print_process_stats_map() const
+{
+    print_process_stats(process_stats_table_.snapshot());
+}
 
-    int page_faults_sum = 0;
-    int eviction_sum = 0;
-    int residency_sum = 0;
+void print_process_stats(const std::map<pid, ProcessStats> &stats)
+{
+    int64_t page_faults_sum = 0;
+    int64_t eviction_sum = 0;
+    int64_t residency_sum = 0;
 
-    for (auto pstat : process_stats_map_)
+    for (auto &pstat : stats)
     {
         std::cout << "Process " << pstat.first << " had " << pstat.second << std::endl;
         page_faults_sum += pstat.second.page_fault_count;
@@ -294,6 +371,41 @@ void Pager::print_process_stats_map() const
     }
 }
 
+void PagerBase::print_process_histograms(std::ostream &stream) const
+{
+    if (!HISTOGRAMS_)
+        return;
+
+    const char *names[] = {"residency", "inter-fault", "reuse"};
+
+    stream << "\n" << std::left << std::setw(24) << "Distribution"
+           << std::setw(10) << "count" << std::setw(12) << "mean"
+           << std::setw(10) << "p50" << std::setw(10) << "p90"
+           << std::setw(10) << "p99" << "max" << std::endl;
+
+    for (size_t pid = 0; pid < process_histograms_.size(); pid++)
+    {
+        if (!process_histograms_[pid])
+            continue;
+
+        const ProcessHistograms &entry = *process_histograms_[pid];
+        const LogHistogram *histograms[] = {&entry.residency, &entry.inter_fault, &entry.reuse};
+
+        for (int i = 0; i < 3; i++)
+        {
+            const LogHistogram &h = *histograms[i];
+
+            std::ostringstream label;
+            label << "Process " << pid << " " << names[i];
+
+            stream << std::setw(24) << label.str() << std::setw(10) << h.count()
+                   << std::setw(12) << h.mean() << std::setw(10) << h.percentile(50)
+                   << std::setw(10) << h.percentile(90) << std::setw(10) << h.percentile(99)
+                   << h.max() << std::endl;
+        }
+    }
+}
+
 std::ostream &operator<<(std::ostream &stream, const ProcessStats &p)
 {
     stream << p.page_fault_count << " faults";
@@ -308,4 +420,15 @@ std::ostream &operator<<(std::ostream &stream, const ProcessStats &p)
     return stream;
 }
 
-} // namespace pager
\ No newline at end of file
+template class Pager<FifoPolicy>;
+template class Pager<LruPolicy>;
+template class Pager<RandomPolicy>;
+template class Pager<OptPolicy>;
+template class Pager<ClockPolicy>;
+template class Pager<EnhancedClockPolicy>;
+template class Pager<GClockPolicy>;
+template class Pager<ArcPolicy>;
+template class Pager<TwoQueuePolicy>;
+template class Pager<LirsPolicy>;
+
+} // namespace pager
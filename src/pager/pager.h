@@ -1,8 +1,18 @@
 #ifndef H_PAGER
 #define H_PAGER
 
+#include <cstdint>
 #include <iostream>
 #include <map>
+#include <memory>
+#include <vector>
+
+#include "costmodel.h"
+#include "loghistogram.h"
+#include "evictionlistener.h"
+#include "pageindex.h"
+#include "refsink.h"
+#include "statstable.h"
 
 namespace io
 {
@@ -10,6 +20,11 @@ class RandIntReader;
 struct UserInput;
 }
 
+namespace driver
+{
+class JobMix;
+}
+
 namespace pager
 {
 
@@ -17,78 +32,152 @@ enum AlgoName
 {
     FIFO,
     RANDOM,
-    LRU
+    LRU,
+    OPT,   /* Belady's optimal replacement; needs the whole reference stream in advance */
+    CLOCK, /* second chance with a reference bit */
+    ESC,   /* enhanced second chance over (reference, modify) bit classes */
+    GCLOCK, /* generalized clock with a use counter */
+    ARC,    /* adaptive replacement cache */
+    TWOQ,   /* 2Q */
+    LIRS    /* low inter-reference recency set */
 };
 
+/* Snapshot of the counters of one process (see ProcessStatsTable) */
 struct ProcessStats
 {
-    int sum_residency_time;
-    int page_fault_count;
-    int eviction_count;
+    int64_t sum_residency_time;
+    int64_t page_fault_count;
+    int64_t eviction_count;
 
     ProcessStats() : sum_residency_time(0), page_fault_count(0), eviction_count(0){};
 
-    ProcessStats(int sum_residency_time)
-        : sum_residency_time(sum_residency_time), page_fault_count(0), eviction_count(0){};
+    friend std::ostream &operator<<(std::ostream &stream, const ProcessStats &p);
+};
 
-    void incr_eviction_count()
-    {
-        eviction_count++;
-    }
+typedef int pid;
 
-    void incr_page_fault_count()
-    {
-        page_fault_count++;
-    }
+/**
+ * Distributions behind the averages of ProcessStats, kept with --histograms:
+ * residency time of evicted pages, time between successive faults of the
+ * process, and reuse time (references between successive uses of a page).
+ */
+struct ProcessHistograms
+{
+    LogHistogram residency;
+    LogHistogram inter_fault;
+    LogHistogram reuse;
 
-    friend std::ostream &operator<<(std::ostream &stream, const ProcessStats &p);
+    int last_fault_time;
+    std::vector<int> last_use; /* last_use[page]: time of the latest reference, 0 if none; one per page */
+
+    ProcessHistograms(int page_count) : last_fault_time(0), last_use(page_count, 0){};
 };
 
-typedef int pid;
+/* Faults and average residency per process, then the totals */
+void print_process_stats(const std::map<pid, ProcessStats> &stats);
 
 class Frame;
 
-class Pager
+/**
+ * State and bookkeeping shared by every replacement policy: the frame table,
+ * the resident page index and the per-process statistics.
+ */
+class PagerBase : public ReferenceSink
 {
 public:
-    Pager(const io::UserInput &uin, io::RandIntReader &randintreader);
-    ~Pager();
-    void reference_by_virtual_addr(int viraddr, int pid, int time_accessed);
+    PagerBase(const io::UserInput &uin);
+    virtual ~PagerBase();
 
-private:
+    /* Snapshot of the statistics so far; may be taken from another thread while the pager runs */
+    std::map<pid, ProcessStats> process_stats() const;
+    void print_process_stats_map() const;
+
+    /* p50/p90/p99/max of each histogram next to its mean; nothing without --histograms */
+    void print_process_histograms(std::ostream &stream) const;
+
+    /* Told about every page the pager evicts; not owned, may be nullptr. */
+    void set_eviction_listener(EvictionListener *listener);
+
+    /* Cycles charged to each process; nullptr unless the cost model is enabled */
+    const CostModel *cost_model() const;
+
+protected:
     bool can_insert() const;
-    bool insert_front(Frame frame);
+    int insert_front(const Frame &frame);
 
     void init_process_stats(const Frame &frame);
     void record_process_stats_before_eviction(const Frame &oldframe, const Frame &newframe);
-    bool write_frame_at_index(int idx, Frame newframe);
+    bool write_frame_at_index(int idx, const Frame &newframe);
 
-    int search_frame(Frame target) const;
-    int search_oldest_frame() const;
-    int search_least_recently_used_frame() const;
+    int search_frame(const Frame &target) const;
 
-    void swap_frame(Frame newframe);
-    void fifo_swap(Frame newframe);
-    void random_swap(Frame newframe);
-    void lru_swap(Frame newframe);
+    void record_histograms(int pid, int page_id, int time_accessed, bool is_fault);
+    ProcessHistograms &histograms_of(int pid);
+    ProcessHistograms &add_histograms(int pid);
 
-    void print_process_stats_map() const;
+    /* Whether the reference of pid at time_accessed writes its page, at rate WRITE_RATIO_ */
+    bool is_write(int pid, int time_accessed) const;
 
     const int MACHINE_SIZE_;
     const int PAGE_SIZE_;
     const int FRAME_COUNT_;
-    const AlgoName ALGO_NAME_;
+    const bool DEBUG_;
+    const bool HISTOGRAMS_;
+    const double WRITE_RATIO_;
+    const int PROC_SIZE_;
+    const driver::JobMix *JOB_MIX_; /* sizes of the processes; nullptr for a job mix that is not defined */
 
     static const int ERR_PAGE_NOT_FOUND_;
-    static const int WARN_FRAME_TABLE_EMPTY_;
+    static const int ERR_NO_FREE_FRAME_;
 
-    io::RandIntReader &randintreader_;
     Frame *frame_table_;
+    PageIndex page_index_;
     int next_insertion_idx_;
 
-    std::map<pid, ProcessStats> process_stats_map_;
+    ProcessStatsTable process_stats_table_;
+    std::vector<std::unique_ptr<ProcessHistograms>> process_histograms_; /* indexed by pid, nullptr until seen */
+
+    EvictionListener *eviction_listener_;
+    CostModel *cost_model_;
+
+private:
+    PagerBase(const PagerBase &);
+    PagerBase &operator=(const PagerBase &);
+};
+
+/**
+ * Pager specialized at compile time on a replacement policy. A policy provides
+ * the hooks
+ *
+ *      void on_hit(int idx, int time_accessed);   page in frame idx referenced
+ *      void on_fault(int idx);                    page loaded into frame idx
+ *      int select_victim(const Frame &incoming);  frame to evict for incoming
+ *      void on_evict(int idx);                    frame idx is being evicted
+ *
+ * which are inlined into the reference path. A hit is left entirely to the
+ * policy: LRU stamps the access time, the clock policies only set a bit. The
+ * reference path is compiled twice, with and without debug tracing, and picked
+ * by a single branch per reference, or per batch of references.
+ */
+template <class Policy>
+class Pager : public PagerBase
+{
+public:
+    Pager(const io::UserInput &uin, io::RandIntReader &randintreader,
+          const std::vector<uint64_t> *next_use);
+    void reference_by_virtual_addr(int viraddr, int pid, int time_accessed) override;
+    void reference_batch(const int *viraddrs, int count, int pid, int first_time) override;
+
+private:
+    template <bool TRACE>
+    void reference(int viraddr, int pid, int time_accessed);
+
+    template <bool TRACE>
+    int swap_frame(const Frame &newframe);
+
+    Policy policy_;
 };
 
 } // namespace pager
 
-#endif
\ No newline at end of file
+#endif
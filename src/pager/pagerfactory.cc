@@ -0,0 +1,49 @@
+#include "pagerfactory.h"
+
+#include "pager.h"
+#include "policy_fifo.h"
+#include "policy_lru.h"
+#include "policy_rand.h"
+#include "policy_opt.h"
+#include "policy_clock.h"
+#include "policy_arc.h"
+#include "policy_2q.h"
+#include "policy_lirs.h"
+#include "../io/uin.h"
+
+namespace pager
+{
+
+std::unique_ptr<PagerBase> make_pager(const io::UserInput &uin, io::RandIntReader &randintreader,
+                                      const std::vector<uint64_t> *next_use)
+{
+    switch (uin.algoname)
+    {
+    case FIFO:
+        return std::unique_ptr<PagerBase>{new Pager<FifoPolicy>(uin, randintreader, next_use)};
+    case LRU:
+        return std::unique_ptr<PagerBase>{new Pager<LruPolicy>(uin, randintreader, next_use)};
+    case RANDOM:
+        return std::unique_ptr<PagerBase>{new Pager<RandomPolicy>(uin, randintreader, next_use)};
+    case OPT:
+        if (!next_use)
+            return nullptr;
+        return std::unique_ptr<PagerBase>{new Pager<OptPolicy>(uin, randintreader, next_use)};
+    case CLOCK:
+        return std::unique_ptr<PagerBase>{new Pager<ClockPolicy>(uin, randintreader, next_use)};
+    case ESC:
+        return std::unique_ptr<PagerBase>{new Pager<EnhancedClockPolicy>(uin, randintreader, next_use)};
+    case GCLOCK:
+        return std::unique_ptr<PagerBase>{new Pager<GClockPolicy>(uin, randintreader, next_use)};
+    case ARC:
+        return std::unique_ptr<PagerBase>{new Pager<ArcPolicy>(uin, randintreader, next_use)};
+    case TWOQ:
+        return std::unique_ptr<PagerBase>{new Pager<TwoQueuePolicy>(uin, randintreader, next_use)};
+    case LIRS:
+        return std::unique_ptr<PagerBase>{new Pager<LirsPolicy>(uin, randintreader, next_use)};
+    default:
+        return nullptr;
+    }
+}
+
+} // namespace pager
@@ -0,0 +1,28 @@
+#ifndef H_PAGERFACTORY
+#define H_PAGERFACTORY
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace io
+{
+class RandIntReader;
+struct UserInput;
+}
+
+namespace pager
+{
+class PagerBase;
+
+/**
+ * Instantiates the pager specialized on the replacement algorithm in uin.
+ * OPT also needs the next-use index of the reference stream it will be fed
+ * (see trace::compute_next_use); it returns nullptr without one.
+ */
+std::unique_ptr<PagerBase> make_pager(const io::UserInput &uin, io::RandIntReader &randintreader,
+                                      const std::vector<uint64_t> *next_use = nullptr);
+
+} // namespace pager
+
+#endif
@@ -0,0 +1,39 @@
+#ifndef H_POLICY
+#define H_POLICY
+
+#include <cstdint>
+#include <vector>
+
+namespace io
+{
+class RandIntReader;
+}
+
+namespace pager
+{
+class Frame;
+
+/* Identifies a page across processes, for policies that remember pages by key. */
+inline uint64_t page_key(int pid, int page_id)
+{
+    return ((uint64_t)(uint32_t)pid << 32) | (uint32_t)page_id;
+}
+
+/* Everything a replacement policy may draw on when it is constructed. */
+struct PolicyContext
+{
+    int frame_count;
+    Frame *frame_table;
+    io::RandIntReader &randintreader;
+
+    /* next_use[i]: position of the next reference to the page of reference i (offline policies only) */
+    const std::vector<uint64_t> *next_use;
+
+    PolicyContext(int frame_count, Frame *frame_table, io::RandIntReader &randintreader,
+                  const std::vector<uint64_t> *next_use)
+        : frame_count(frame_count), frame_table(frame_table),
+          randintreader(randintreader), next_use(next_use) {}
+};
+} // namespace pager
+
+#endif
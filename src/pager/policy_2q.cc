@@ -0,0 +1,67 @@
+#include "policy_2q.h"
+
+#include <algorithm>
+
+#include "frame.h"
+
+namespace pager
+{
+TwoQueuePolicy::TwoQueuePolicy(const PolicyContext &context)
+    : KIN_(std::max(1, context.frame_count / 4)), KOUT_(std::max(1, context.frame_count / 2)),
+      frame_table_(context.frame_table),
+      a1in_(context.frame_count), am_(context.frame_count), a1out_(KOUT_ + 1),
+      queue_of_(context.frame_count, NONE) {}
+
+void TwoQueuePolicy::on_hit(int idx, int time_accessed)
+{
+    /* A1in is a FIFO: hits there are correlated references and change nothing */
+    if (queue_of_[idx] == AM)
+        am_.move_to_front(idx);
+}
+
+int TwoQueuePolicy::select_victim(const Frame &incoming)
+{
+    if (a1in_.size() > KIN_ || am_.empty())
+        return a1in_.back();
+
+    return am_.back();
+}
+
+void TwoQueuePolicy::on_evict(int idx)
+{
+    if (queue_of_[idx] == A1IN)
+    {
+        const Frame &victim = frame_table_[idx];
+
+        a1in_.remove(idx);
+        a1out_.push_front(page_key(victim.pid(), victim.page_id()));
+
+        if (a1out_.size() > KOUT_)
+            a1out_.pop_back();
+    }
+    else
+    {
+        am_.remove(idx);
+    }
+
+    queue_of_[idx] = NONE;
+}
+
+void TwoQueuePolicy::on_fault(int idx)
+{
+    const Frame &frame = frame_table_[idx];
+    uint64_t key = page_key(frame.pid(), frame.page_id());
+
+    if (a1out_.contains(key))
+    {
+        a1out_.remove(key);
+        am_.push_front(idx);
+        queue_of_[idx] = AM;
+    }
+    else
+    {
+        a1in_.push_front(idx);
+        queue_of_[idx] = A1IN;
+    }
+}
+} // namespace pager
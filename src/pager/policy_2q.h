@@ -0,0 +1,48 @@
+#ifndef H_POLICY_2Q
+#define H_POLICY_2Q
+
+#include <vector>
+
+#include "ghostlist.h"
+#include "policy.h"
+#include "recencylist.h"
+
+namespace pager
+{
+/**
+ * Full 2Q (Johnson and Shasha). A first reference loads the page into A1in, a
+ * FIFO of about a quarter of the frames; pages evicted from A1in are
+ * remembered in A1out. Only a fault on a page remembered in A1out promotes it
+ * to Am, the LRU-managed main queue, so pages referenced once by a scan pass
+ * through A1in without displacing the working set in Am.
+ */
+class TwoQueuePolicy
+{
+public:
+    TwoQueuePolicy(const PolicyContext &context);
+
+    void on_hit(int idx, int time_accessed);
+    void on_fault(int idx);
+    int select_victim(const Frame &incoming);
+    void on_evict(int idx);
+
+private:
+    enum Queue
+    {
+        NONE,
+        A1IN,
+        AM
+    };
+
+    const int KIN_;  /* target size of A1in */
+    const int KOUT_; /* capacity of A1out */
+    Frame *frame_table_;
+
+    RecencyList a1in_;
+    RecencyList am_;
+    GhostList a1out_;
+    std::vector<Queue> queue_of_;
+};
+} // namespace pager
+
+#endif
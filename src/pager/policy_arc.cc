@@ -0,0 +1,115 @@
+#include "policy_arc.h"
+
+#include <algorithm>
+
+#include "frame.h"
+
+namespace pager
+{
+ArcPolicy::ArcPolicy(const PolicyContext &context)
+    : FRAME_COUNT_(context.frame_count), frame_table_(context.frame_table),
+      t1_(context.frame_count), t2_(context.frame_count),
+      b1_(context.frame_count + 1), b2_(context.frame_count + 1),
+      list_of_(context.frame_count, NONE), target_t1_(0), remember_victim_(true) {}
+
+void ArcPolicy::on_hit(int idx, int time_accessed)
+{
+    if (list_of_[idx] == T1)
+    {
+        t1_.remove(idx);
+        t2_.push_front(idx);
+        list_of_[idx] = T2;
+    }
+    else
+    {
+        t2_.move_to_front(idx);
+    }
+}
+
+int ArcPolicy::select_victim(const Frame &incoming)
+{
+    uint64_t key = page_key(incoming.pid(), incoming.page_id());
+
+    remember_victim_ = true;
+
+    if (b1_.contains(key))
+    {
+        double delta = std::max(1.0, b2_.size() / (double)b1_.size());
+        target_t1_ = std::min((double)FRAME_COUNT_, target_t1_ + delta);
+        return replace(false);
+    }
+
+    if (b2_.contains(key))
+    {
+        double delta = std::max(1.0, b1_.size() / (double)b2_.size());
+        target_t1_ = std::max(0.0, target_t1_ - delta);
+        return replace(true);
+    }
+
+    if (t1_.size() + b1_.size() >= FRAME_COUNT_)
+    {
+        if (t1_.size() < FRAME_COUNT_)
+        {
+            b1_.pop_back();
+            return replace(false);
+        }
+
+        /* T1 fills the cache: drop its LRU page without remembering it */
+        remember_victim_ = false;
+        return t1_.back();
+    }
+
+    if (t1_.size() + t2_.size() + b1_.size() + b2_.size() >= 2 * FRAME_COUNT_)
+        b2_.pop_back();
+
+    return replace(false);
+}
+
+int ArcPolicy::replace(bool incoming_in_b2)
+{
+    bool take_t1 = !t1_.empty() &&
+                   (t1_.size() > target_t1_ || (incoming_in_b2 && t1_.size() == (int)target_t1_) || t2_.empty());
+
+    return take_t1 ? t1_.back() : t2_.back();
+}
+
+void ArcPolicy::on_evict(int idx)
+{
+    const Frame &victim = frame_table_[idx];
+    uint64_t key = page_key(victim.pid(), victim.page_id());
+
+    if (list_of_[idx] == T1)
+    {
+        t1_.remove(idx);
+        if (remember_victim_)
+            b1_.push_front(key);
+    }
+    else
+    {
+        t2_.remove(idx);
+        if (remember_victim_)
+            b2_.push_front(key);
+    }
+
+    list_of_[idx] = NONE;
+}
+
+void ArcPolicy::on_fault(int idx)
+{
+    const Frame &frame = frame_table_[idx];
+    uint64_t key = page_key(frame.pid(), frame.page_id());
+
+    if (b1_.contains(key) || b2_.contains(key))
+    {
+        b1_.remove(key);
+        b2_.remove(key);
+        t2_.push_front(idx);
+        list_of_[idx] = T2;
+    }
+    else
+    {
+        t1_.push_front(idx);
+        list_of_[idx] = T1;
+    }
+}
+} // namespace pager
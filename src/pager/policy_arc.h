@@ -0,0 +1,53 @@
+#ifndef H_POLICY_ARC
+#define H_POLICY_ARC
+
+#include <vector>
+
+#include "ghostlist.h"
+#include "policy.h"
+#include "recencylist.h"
+
+namespace pager
+{
+/**
+ * ARC (Megiddo and Modha). Resident pages are split between T1, pages seen
+ * once recently, and T2, pages seen at least twice; B1 and B2 remember the
+ * keys recently evicted from each. A fault on a key in B1 (B2) grows (shrinks)
+ * the target size p of T1, and eviction takes the LRU page of T1 or T2
+ * depending on p, so a long sequential scan only ever churns T1.
+ */
+class ArcPolicy
+{
+public:
+    ArcPolicy(const PolicyContext &context);
+
+    void on_hit(int idx, int time_accessed);
+    void on_fault(int idx);
+    int select_victim(const Frame &incoming);
+    void on_evict(int idx);
+
+private:
+    enum List
+    {
+        NONE,
+        T1,
+        T2
+    };
+
+    int replace(bool incoming_in_b2);
+
+    const int FRAME_COUNT_;
+    Frame *frame_table_;
+
+    RecencyList t1_;
+    RecencyList t2_;
+    GhostList b1_;
+    GhostList b2_;
+    std::vector<List> list_of_; /* list_of_[idx]: list holding frame idx */
+
+    double target_t1_; /* p */
+    bool remember_victim_;
+};
+} // namespace pager
+
+#endif
@@ -0,0 +1,14 @@
+#include "policy_clock.h"
+
+namespace pager
+{
+ClockPolicy::ClockPolicy(const PolicyContext &context)
+    : frame_table_(context.frame_table), hand_(context.frame_count) {}
+
+EnhancedClockPolicy::EnhancedClockPolicy(const PolicyContext &context)
+    : FRAME_COUNT_(context.frame_count), frame_table_(context.frame_table), hand_(context.frame_count) {}
+
+GClockPolicy::GClockPolicy(const PolicyContext &context)
+    : frame_table_(context.frame_table), hand_(context.frame_count) {}
+
+} // namespace pager
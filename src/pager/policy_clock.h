@@ -0,0 +1,153 @@
+#ifndef H_POLICY_CLOCK
+#define H_POLICY_CLOCK
+
+#include "frame.h"
+#include "policy.h"
+
+namespace pager
+{
+/**
+ * Clock hand shared by the clock policies. It sweeps the frame table from the
+ * highest index down, wrapping around, which is the order frames are first
+ * filled in; without hits every clock policy therefore evicts like FIFO.
+ */
+class ClockHand
+{
+public:
+    ClockHand(int frame_count) : FRAME_COUNT_(frame_count), hand_(frame_count - 1) {}
+
+    int position() const { return hand_; }
+
+    void advance()
+    {
+        hand_--;
+        if (hand_ < 0)
+            hand_ = FRAME_COUNT_ - 1;
+    }
+
+private:
+    const int FRAME_COUNT_;
+    int hand_;
+};
+
+/**
+ * CLOCK (second chance). A hit only sets the frame's reference bit; the hand
+ * clears set bits as it passes and evicts the first frame whose bit is clear.
+ */
+class ClockPolicy
+{
+public:
+    ClockPolicy(const PolicyContext &context);
+
+    void on_hit(int idx, int time_accessed) { frame_table_[idx].set_referenced(true); }
+    void on_fault(int idx) { frame_table_[idx].set_referenced(true); }
+    void on_evict(int idx) { hand_.advance(); }
+
+    int select_victim(const Frame &incoming)
+    {
+        while (frame_table_[hand_.position()].is_referenced())
+        {
+            frame_table_[hand_.position()].set_referenced(false);
+            hand_.advance();
+        }
+
+        return hand_.position();
+    }
+
+private:
+    Frame *frame_table_;
+    ClockHand hand_;
+};
+
+/**
+ * Enhanced second chance. Frames fall into four classes by (reference bit,
+ * modify bit); the hand looks for the lowest class, preferring clean pages to
+ * dirty ones since they can be dropped without a write-back:
+ *
+ *      1. sweep for (0, 0), changing nothing;
+ *      2. sweep for (0, 1), clearing reference bits on the way;
+ *      3. repeat; every frame is now (0, x), so a victim is found.
+ */
+class EnhancedClockPolicy
+{
+public:
+    EnhancedClockPolicy(const PolicyContext &context);
+
+    void on_hit(int idx, int time_accessed) { frame_table_[idx].set_referenced(true); }
+    void on_fault(int idx) { frame_table_[idx].set_referenced(true); }
+    void on_evict(int idx) { hand_.advance(); }
+
+    int select_victim(const Frame &incoming)
+    {
+        for (int round = 0; round < 2; round++)
+        {
+            for (int i = 0; i < FRAME_COUNT_; i++, hand_.advance())
+            {
+                const Frame &frame = frame_table_[hand_.position()];
+
+                if (!frame.is_referenced() && !frame.is_modified())
+                    return hand_.position();
+            }
+
+            for (int i = 0; i < FRAME_COUNT_; i++, hand_.advance())
+            {
+                Frame &frame = frame_table_[hand_.position()];
+
+                if (!frame.is_referenced())
+                    return hand_.position();
+
+                frame.set_referenced(false);
+            }
+        }
+
+        return hand_.position();
+    }
+
+private:
+    const int FRAME_COUNT_;
+    Frame *frame_table_;
+    ClockHand hand_;
+};
+
+/**
+ * GCLOCK. Each frame carries a use counter, set on load and incremented on
+ * every hit up to a cap; the hand decrements counters as it passes and evicts
+ * the first frame whose counter is zero. The cap bounds every sweep.
+ */
+class GClockPolicy
+{
+public:
+    GClockPolicy(const PolicyContext &context);
+
+    void on_hit(int idx, int time_accessed)
+    {
+        Frame &frame = frame_table_[idx];
+        if (frame.use_count() < MAX_USE_COUNT_)
+            frame.set_use_count(frame.use_count() + 1);
+    }
+
+    void on_fault(int idx) { frame_table_[idx].set_use_count(INITIAL_USE_COUNT_); }
+    void on_evict(int idx) { hand_.advance(); }
+
+    int select_victim(const Frame &incoming)
+    {
+        while (frame_table_[hand_.position()].use_count() > 0)
+        {
+            Frame &frame = frame_table_[hand_.position()];
+            frame.set_use_count(frame.use_count() - 1);
+            hand_.advance();
+        }
+
+        return hand_.position();
+    }
+
+private:
+    static const int INITIAL_USE_COUNT_ = 1;
+    static const int MAX_USE_COUNT_ = 4;
+
+    Frame *frame_table_;
+    ClockHand hand_;
+};
+} // namespace pager
+
+#endif
@@ -0,0 +1,8 @@
+#include "policy_fifo.h"
+
+namespace pager
+{
+FifoPolicy::FifoPolicy(const PolicyContext &context)
+    : load_ring_(context.frame_count) {}
+
+} // namespace pager
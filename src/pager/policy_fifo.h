@@ -0,0 +1,25 @@
+#ifndef H_POLICY_FIFO
+#define H_POLICY_FIFO
+
+#include "loadring.h"
+#include "policy.h"
+
+namespace pager
+{
+/* Evicts the frame whose page was loaded earliest. */
+class FifoPolicy
+{
+public:
+    FifoPolicy(const PolicyContext &context);
+
+    void on_hit(int idx, int time_accessed) {}
+    void on_fault(int idx) { load_ring_.push_back(idx); }
+    int select_victim(const Frame &incoming) const { return load_ring_.front(); }
+    void on_evict(int idx) { load_ring_.pop_front(); }
+
+private:
+    LoadRing load_ring_;
+};
+} // namespace pager
+
+#endif
@@ -0,0 +1,184 @@
+#include "policy_lirs.h"
+
+#include <algorithm>
+
+#include "frame.h"
+
+namespace pager
+{
+LirsPolicy::LirsPolicy(const PolicyContext &context)
+    : LIR_LIMIT_(context.frame_count - std::max(1, context.frame_count / 100)),
+      NONRESIDENT_LIMIT_(2 * context.frame_count),
+      frame_table_(context.frame_table),
+      stack_(context.frame_count + NONRESIDENT_LIMIT_ + 1), hir_queue_(context.frame_count),
+      nonresident_(NONRESIDENT_LIMIT_ + 1), entries_(context.frame_count + NONRESIDENT_LIMIT_ + 1),
+      entry_index_((int)entries_.size()), lir_count_(0)
+{
+    /* Resident pages plus at most NONRESIDENT_LIMIT_ + 1 ghosts ever hold an entry */
+
+    free_nodes_.reserve(entries_.size());
+
+    for (int node = (int)entries_.size() - 1; node >= 0; node--)
+        free_nodes_.push_back(node);
+}
+
+uint64_t LirsPolicy::key_of(int idx) const
+{
+    return page_key(frame_table_[idx].pid(), frame_table_[idx].page_id());
+}
+
+LirsPolicy::Entry &LirsPolicy::entry_of(uint64_t key)
+{
+    int pid = (int)(key >> 32);
+    int page_id = (int)(uint32_t)key;
+    int node = entry_index_.find(pid, page_id);
+
+    if (node == PageIndex::NOT_FOUND)
+    {
+        node = free_nodes_.back();
+        free_nodes_.pop_back();
+        entry_index_.insert(pid, page_id, node);
+        entries_[node] = Entry();
+    }
+
+    return entries_[node];
+}
+
+void LirsPolicy::release(uint64_t key)
+{
+    int pid = (int)(key >> 32);
+    int page_id = (int)(uint32_t)key;
+
+    free_nodes_.push_back(entry_index_.find(pid, page_id));
+    entry_index_.erase(pid, page_id);
+}
+
+void LirsPolicy::on_hit(int idx, int time_accessed)
+{
+    uint64_t key = key_of(idx);
+    Entry &entry = entry_of(key);
+
+    if (entry.is_lir)
+    {
+        bool was_bottom = (stack_.back() == key);
+        stack_.push_front(key);
+
+        if (was_bottom)
+            prune();
+    }
+    else if (stack_.contains(key) && LIR_LIMIT_ > 0)
+    {
+        hir_queue_.remove(key);
+        promote(key, entry);
+    }
+    else
+    {
+        stack_.push_front(key);
+        hir_queue_.push_front(key);
+    }
+}
+
+int LirsPolicy::select_victim(const Frame &incoming)
+{
+    return entry_of(hir_queue_.back()).frame_idx;
+}
+
+void LirsPolicy::on_evict(int idx)
+{
+    uint64_t key = key_of(idx);
+
+    hir_queue_.remove(key);
+
+    if (stack_.contains(key))
+    {
+        entry_of(key).is_resident = false;
+        nonresident_.push_front(key);
+        trim_nonresident();
+    }
+    else
+    {
+        release(key);
+    }
+}
+
+void LirsPolicy::on_fault(int idx)
+{
+    uint64_t key = key_of(idx);
+    Entry &entry = entry_of(key);
+
+    bool was_in_stack = stack_.contains(key);
+
+    if (was_in_stack)
+        nonresident_.remove(key);
+
+    entry.is_resident = true;
+    entry.frame_idx = idx;
+
+    if (lir_count_ < LIR_LIMIT_)
+    {
+        /* Until the LIR set is full every page becomes LIR */
+        entry.is_lir = true;
+        lir_count_++;
+        stack_.push_front(key);
+    }
+    else if (was_in_stack && LIR_LIMIT_ > 0)
+    {
+        promote(key, entry);
+    }
+    else
+    {
+        entry.is_lir = false;
+        stack_.push_front(key);
+        hir_queue_.push_front(key);
+    }
+}
+
+void LirsPolicy::promote(uint64_t key, Entry &entry)
+{
+    entry.is_lir = true;
+    lir_count_++;
+    stack_.push_front(key);
+    demote_bottom();
+}
+
+void LirsPolicy::demote_bottom()
+{
+    uint64_t bottom = stack_.pop_back();
+
+    entry_of(bottom).is_lir = false;
+    lir_count_--;
+    hir_queue_.push_front(bottom);
+
+    prune();
+}
+
+void LirsPolicy::prune()
+{
+    while (!stack_.empty())
+    {
+        uint64_t bottom = stack_.back();
+        const Entry &entry = entry_of(bottom);
+
+        if (entry.is_lir)
+            break;
+
+        stack_.pop_back();
+
+        if (!entry.is_resident)
+        {
+            nonresident_.remove(bottom);
+            release(bottom);
+        }
+    }
+}
+
+void LirsPolicy::trim_nonresident()
+{
+    while (nonresident_.size() > NONRESIDENT_LIMIT_)
+    {
+        uint64_t oldest = nonresident_.pop_back();
+        stack_.remove(oldest);
+        release(oldest);
+    }
+}
+} // namespace pager
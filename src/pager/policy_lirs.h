@@ -0,0 +1,63 @@
+#ifndef H_POLICY_LIRS
+#define H_POLICY_LIRS
+
+#include <vector>
+
+#include "ghostlist.h"
+#include "pageindex.h"
+#include "policy.h"
+
+namespace pager
+{
+/**
+ * LIRS (Jiang and Zhang). Pages with a low inter-reference recency (LIR) hold
+ * all but about 1% of the frames; the rest hold high inter-reference recency
+ * (HIR) pages and are the only eviction candidates. The recency stack S keeps
+ * LIR pages and recently seen HIR pages, resident or not, and is pruned so its
+ * bottom is always LIR; a HIR page referenced again while still in S has
+ * proven a short reuse distance and swaps places with the bottom LIR page.
+ * Q lists the resident HIR pages in FIFO order. Non-resident entries in S are
+ * capped at twice the frame count to bound memory, so the state of every page
+ * in S or Q fits a pool of entries allocated up front.
+ */
+class LirsPolicy
+{
+public:
+    LirsPolicy(const PolicyContext &context);
+
+    void on_hit(int idx, int time_accessed);
+    void on_fault(int idx);
+    int select_victim(const Frame &incoming);
+    void on_evict(int idx);
+
+private:
+    struct Entry
+    {
+        bool is_lir;
+        bool is_resident;
+        int frame_idx;
+    };
+
+    uint64_t key_of(int idx) const;
+    Entry &entry_of(uint64_t key);
+    void release(uint64_t key);
+    void promote(uint64_t key, Entry &entry);
+    void demote_bottom();
+    void prune();
+    void trim_nonresident();
+
+    const int LIR_LIMIT_;
+    const int NONRESIDENT_LIMIT_;
+    Frame *frame_table_;
+
+    GhostList stack_;       /* S: front is the top */
+    GhostList hir_queue_;   /* Q: front is the newest */
+    GhostList nonresident_; /* non-resident HIR pages in S, oldest at the back */
+    std::vector<Entry> entries_; /* entries_[node] */
+    std::vector<int> free_nodes_;
+    PageIndex entry_index_; /* node of every page in S or Q */
+    int lir_count_;
+};
+} // namespace pager
+
+#endif
@@ -0,0 +1,8 @@
+#include "policy_lru.h"
+
+namespace pager
+{
+LruPolicy::LruPolicy(const PolicyContext &context)
+    : frame_table_(context.frame_table), recency_list_(context.frame_count) {}
+
+} // namespace pager
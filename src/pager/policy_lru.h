@@ -0,0 +1,36 @@
+#ifndef H_POLICY_LRU
+#define H_POLICY_LRU
+
+#include "frame.h"
+#include "recencylist.h"
+#include "policy.h"
+
+namespace pager
+{
+/**
+ * Evicts the frame with the oldest access time. Access times are unique per
+ * reference, so the back of the recency list is exactly that frame. LRU is the
+ * only policy that stamps the frame's access time on a hit.
+ */
+class LruPolicy
+{
+public:
+    LruPolicy(const PolicyContext &context);
+
+    void on_hit(int idx, int time_accessed)
+    {
+        frame_table_[idx].set_latest_access_time(time_accessed);
+        recency_list_.move_to_front(idx);
+    }
+
+    void on_fault(int idx) { recency_list_.push_front(idx); }
+    int select_victim(const Frame &incoming) const { return recency_list_.back(); }
+    void on_evict(int idx) { recency_list_.remove(idx); }
+
+private:
+    Frame *frame_table_;
+    RecencyList recency_list_;
+};
+} // namespace pager
+
+#endif
@@ -0,0 +1,8 @@
+#include "policy_opt.h"
+
+namespace pager
+{
+OptPolicy::OptPolicy(const PolicyContext &context)
+    : next_use_(context.next_use), cursor_(0), next_uses_(context.frame_count) {}
+
+} // namespace pager
@@ -0,0 +1,37 @@
+#ifndef H_POLICY_OPT
+#define H_POLICY_OPT
+
+#include <cstdint>
+#include <vector>
+
+#include "indexedheap.h"
+#include "policy.h"
+
+namespace pager
+{
+/**
+ * Belady's optimal replacement over a recorded reference stream: evicts the
+ * frame whose page is referenced again furthest in the future (or never).
+ * Every frame is keyed in a max-heap by the position of its page's next use,
+ * taken from the precomputed next-use index; the policy advances through the
+ * index by one position per reference, so the pager must be fed exactly the
+ * stream the index was computed from.
+ */
+class OptPolicy
+{
+public:
+    OptPolicy(const PolicyContext &context);
+
+    void on_hit(int idx, int time_accessed) { next_uses_.set(idx, (*next_use_)[cursor_++]); }
+    void on_fault(int idx) { next_uses_.set(idx, (*next_use_)[cursor_++]); }
+    int select_victim(const Frame &incoming) const { return next_uses_.top(); }
+    void on_evict(int idx) { next_uses_.remove(idx); }
+
+private:
+    const std::vector<uint64_t> *next_use_;
+    uint64_t cursor_;
+    IndexedHeap next_uses_;
+};
+} // namespace pager
+
+#endif
@@ -0,0 +1,8 @@
+#include "policy_rand.h"
+
+namespace pager
+{
+RandomPolicy::RandomPolicy(const PolicyContext &context)
+    : FRAME_COUNT_(context.frame_count), randintreader_(context.randintreader) {}
+
+} // namespace pager
@@ -0,0 +1,27 @@
+#ifndef H_POLICY_RAND
+#define H_POLICY_RAND
+
+#include "policy.h"
+#include "../io/randintreader.h"
+
+namespace pager
+{
+
+/* Evicts the frame selected by the next random number. */
+class RandomPolicy
+{
+public:
+    RandomPolicy(const PolicyContext &context);
+
+    void on_hit(int idx, int time_accessed) {}
+    void on_fault(int idx) {}
+    int select_victim(const Frame &incoming) { return randintreader_.read_next_int() % FRAME_COUNT_; }
+    void on_evict(int idx) {}
+
+private:
+    const int FRAME_COUNT_;
+    io::RandIntReader &randintreader_;
+};
+} // namespace pager
+
+#endif
@@ -0,0 +1,85 @@
+#include "recencylist.h"
+
+namespace pager
+{
+const int RecencyList::NIL = -1;
+
+RecencyList::RecencyList(int frame_count) : head_(NIL), tail_(NIL), size_(0)
+{
+    prev_ = new int[frame_count];
+    next_ = new int[frame_count];
+    linked_ = new bool[frame_count];
+
+    for (int i = 0; i < frame_count; i++)
+    {
+        prev_[i] = NIL;
+        next_[i] = NIL;
+        linked_[i] = false;
+    }
+}
+
+RecencyList::~RecencyList()
+{
+    delete[] prev_;
+    delete[] next_;
+    delete[] linked_;
+}
+
+bool RecencyList::empty() const { return head_ == NIL; }
+
+int RecencyList::size() const { return size_; }
+
+bool RecencyList::contains(int idx) const { return linked_[idx]; }
+
+int RecencyList::front() const { return head_; }
+
+int RecencyList::back() const { return tail_; }
+
+void RecencyList::push_front(int idx)
+{
+    prev_[idx] = NIL;
+    next_[idx] = head_;
+
+    if (head_ != NIL)
+        prev_[head_] = idx;
+    else
+        tail_ = idx;
+
+    head_ = idx;
+    linked_[idx] = true;
+    size_++;
+}
+
+void RecencyList::move_to_front(int idx)
+{
+    if (head_ == idx)
+        return;
+
+    if (linked_[idx])
+        remove(idx);
+
+    push_front(idx);
+}
+
+void RecencyList::remove(int idx)
+{
+    if (!linked_[idx])
+        return;
+
+    if (prev_[idx] != NIL)
+        next_[prev_[idx]] = next_[idx];
+    else
+        head_ = next_[idx];
+
+    if (next_[idx] != NIL)
+        prev_[next_[idx]] = prev_[idx];
+    else
+        tail_ = prev_[idx];
+
+    prev_[idx] = NIL;
+    next_[idx] = NIL;
+    linked_[idx] = false;
+    size_--;
+}
+
+} // namespace pager
@@ -0,0 +1,41 @@
+#ifndef H_RECENCYLIST
+#define H_RECENCYLIST
+
+namespace pager
+{
+/**
+ * Intrusive doubly linked list over frame indices, ordered from the most
+ * recently used frame (front) to the least recently used frame (back).
+ */
+class RecencyList
+{
+public:
+    RecencyList(int frame_count);
+    ~RecencyList();
+
+    bool empty() const;
+    int size() const;
+    bool contains(int idx) const;
+    int front() const;
+    int back() const;
+
+    void push_front(int idx);
+    void move_to_front(int idx);
+    void remove(int idx);
+
+    static const int NIL;
+
+private:
+    RecencyList(const RecencyList &);
+    RecencyList &operator=(const RecencyList &);
+
+    int *prev_;
+    int *next_;
+    bool *linked_;
+    int head_;
+    int tail_;
+    int size_;
+};
+} // namespace pager
+
+#endif
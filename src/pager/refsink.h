@@ -0,0 +1,33 @@
+#ifndef H_REFSINK
+#define H_REFSINK
+
+namespace pager
+{
+/**
+ * Consumer of the memory reference stream produced by driver::Driver.
+ * Pagers implement it, and so do decorators that observe the stream on its
+ * way to a pager; decorators forward context switches as well.
+ */
+class ReferenceSink
+{
+public:
+    virtual ~ReferenceSink() {}
+    virtual void reference_by_virtual_addr(int viraddr, int pid, int time_accessed) = 0;
+
+    /**
+     * count consecutive references of process pid, at times first_time,
+     * first_time + 1, ...; the same as referencing them one by one, which is
+     * what sinks that do not override it do.
+     */
+    virtual void reference_batch(const int *viraddrs, int count, int pid, int first_time)
+    {
+        for (int i = 0; i < count; i++)
+            reference_by_virtual_addr(viraddrs[i], pid, first_time + i);
+    }
+
+    /* The driver moved the CPU from process from_pid to process to_pid. */
+    virtual void context_switch(int from_pid, int to_pid) {}
+};
+} // namespace pager
+
+#endif
@@ -0,0 +1,119 @@
+#include "shardedpager.h"
+#include "pagerfactory.h"
+#include "policy.h"
+#include "../io/randintreader.h"
+#include "../io/randsource.h"
+#include "../io/uin.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+namespace pager
+{
+namespace
+{
+/* Substream ids of the shards' eviction streams, clear of the per-process and lock-step ids */
+const uint64_t SHARD_STREAM_BASE_ = 2ULL << 32;
+} // namespace
+
+ShardedPager::ShardedPager(const io::UserInput &uin, io::RandIntReader &shared_reader, int shard_count,
+                           bool serialized)
+    : PAGE_SIZE_(uin.page_size), SERIALIZED_(serialized)
+{
+    int frame_count = uin.machine_size / uin.page_size;
+
+    if (shard_count > frame_count)
+        shard_count = frame_count;
+
+    if (shard_count < 1)
+        shard_count = 1;
+
+    /* operator new only guarantees the alignment of fundamental types before C++17 */
+
+    void *memory = nullptr;
+
+    if (posix_memalign(&memory, alignof(Shard), shard_count * sizeof(Shard)) != 0)
+    {
+        std::cout << "Could not allocate the pager shards. Terminating..." << std::endl;
+        exit(10);
+    }
+
+    shards_ = static_cast<Shard *>(memory);
+    shard_count_ = shard_count;
+
+    for (int i = 0; i < shard_count; i++)
+    {
+        Shard *shard = new (&shards_[i]) Shard();
+        shard->latest_time = 0;
+
+        /* Frames are dealt out as evenly as possible */
+
+        io::UserInput config = uin;
+        config.machine_size = (frame_count / shard_count + (i < frame_count % shard_count ? 1 : 0)) *
+                              uin.page_size;
+
+        if (!serialized)
+        {
+            shard->reader = shared_reader.substream(SHARD_STREAM_BASE_ + i);
+
+            /* The random number file cannot be split: read it from an offset of the shard's own */
+            if (!shard->reader)
+                shard->reader.reset(
+                    new io::RandIntReader(io::make_random_source(uin, SHARD_STREAM_BASE_ + i), false));
+        }
+
+        shard->pager = make_pager(config, serialized ? shared_reader : *shard->reader);
+    }
+}
+
+ShardedPager::~ShardedPager()
+{
+    for (int i = 0; i < shard_count_; i++)
+        shards_[i].~Shard();
+
+    free(shards_);
+}
+
+void ShardedPager::reference_by_virtual_addr(int viraddr, int pid, int time_accessed)
+{
+    uint64_t key = page_key(pid, viraddr / PAGE_SIZE_);
+    Shard &shard = shards_[io::CounterRandomSource::mix(key) % shard_count_];
+
+    std::lock_guard<std::mutex> guard(shard.lock);
+
+    if (!SERIALIZED_)
+    {
+        if (time_accessed <= shard.latest_time)
+            time_accessed = shard.latest_time + 1;
+
+        shard.latest_time = time_accessed;
+    }
+
+    shard.pager->reference_by_virtual_addr(viraddr, pid, time_accessed);
+}
+
+int ShardedPager::shard_count() const
+{
+    return shard_count_;
+}
+
+std::map<pid, ProcessStats> ShardedPager::process_stats() const
+{
+    std::map<pid, ProcessStats> merged;
+
+    for (int i = 0; i < shard_count_; i++)
+    {
+        for (auto &pstat : shards_[i].pager->process_stats())
+        {
+            ProcessStats &total = merged[pstat.first];
+
+            total.page_fault_count += pstat.second.page_fault_count;
+            total.eviction_count += pstat.second.eviction_count;
+            total.sum_residency_time += pstat.second.sum_residency_time;
+        }
+    }
+
+    return merged;
+}
+} // namespace pager
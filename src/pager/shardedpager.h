@@ -0,0 +1,70 @@
+#ifndef H_SHARDEDPAGER
+#define H_SHARDEDPAGER
+
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include "pager.h"
+#include "refsink.h"
+
+namespace io
+{
+class RandIntReader;
+struct UserInput;
+}
+
+namespace pager
+{
+/**
+ * Pager that may be referenced from several threads at once. The frames are
+ * split between shard_count independent pagers of the algorithm in uin, each
+ * with its own page index and eviction state behind its own lock; a page is
+ * always paged by the shard its (pid, page) key hashes to, so replacement is
+ * local to a shard, as in a sharded cache. With one shard it is the pager of
+ * uin behind a lock.
+ *
+ * When the caller serializes all references, the shards draw their eviction
+ * numbers from shared_reader and keep the caller's timestamps. Otherwise they
+ * draw from streams of their own, and each shard keeps the stamps it sees
+ * increasing: the callers' clocks drift apart, and a shard must never see a
+ * page evicted at an earlier time than it was loaded. A stamp behind the
+ * shard's latest is moved to just after it, under the shard lock, so no state
+ * but the lock is shared between the callers.
+ */
+class ShardedPager : public ReferenceSink
+{
+public:
+    ShardedPager(const io::UserInput &uin, io::RandIntReader &shared_reader, int shard_count,
+                 bool serialized);
+    ~ShardedPager();
+
+    void reference_by_virtual_addr(int viraddr, int pid, int time_accessed) override;
+
+    int shard_count() const;
+
+    /* Statistics of every shard, summed per process; may be taken while other threads reference */
+    std::map<pid, ProcessStats> process_stats() const;
+
+private:
+    ShardedPager(const ShardedPager &);
+    ShardedPager &operator=(const ShardedPager &);
+
+    /* Aligned to a cache line, so that the locks of neighbouring shards never share one */
+    struct alignas(64) Shard
+    {
+        std::mutex lock;
+        int latest_time; /* latest stamp the shard has seen, unless SERIALIZED_ */
+        std::unique_ptr<io::RandIntReader> reader;
+        std::unique_ptr<PagerBase> pager;
+    };
+
+    const int PAGE_SIZE_;
+    const bool SERIALIZED_;
+
+    Shard *shards_; /* shard_count_ shards in one cache-line aligned allocation */
+    int shard_count_;
+};
+} // namespace pager
+
+#endif
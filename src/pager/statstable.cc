@@ -0,0 +1,93 @@
+#include "statstable.h"
+#include "pager.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+namespace pager
+{
+const int ProcessStatsTable::MAX_PID = 1 << 22;
+
+namespace
+{
+const int ALIGNMENT_ = 64;
+} // namespace
+
+ProcessStatsTable::ProcessStatsTable() : chunks_(MAX_PID / CHUNK_SIZE_)
+{
+    for (auto &chunk : chunks_)
+        chunk.store(nullptr, std::memory_order_relaxed);
+}
+
+ProcessStatsTable::~ProcessStatsTable()
+{
+    for (auto &chunk : chunks_)
+    {
+        Counters *counters = chunk.load(std::memory_order_relaxed);
+
+        if (counters == nullptr)
+            continue;
+
+        for (int i = 0; i < CHUNK_SIZE_; i++)
+            counters[i].~Counters();
+
+        free(counters);
+    }
+}
+
+ProcessStatsTable::Counters *ProcessStatsTable::allocate_chunk(int pid)
+{
+    if (pid < 0 || pid >= MAX_PID)
+    {
+        std::cout << "Process id " << pid << " is out of range of the statistics table. Terminating..."
+                  << std::endl;
+        exit(10);
+    }
+
+    void *memory = nullptr;
+
+    if (posix_memalign(&memory, ALIGNMENT_, CHUNK_SIZE_ * sizeof(Counters)) != 0)
+    {
+        std::cout << "Could not allocate the process statistics. Terminating..." << std::endl;
+        exit(10);
+    }
+
+    /* Constructed in place: operator new only guarantees fundamental alignment before C++17 */
+    Counters *chunk = static_cast<Counters *>(memory);
+
+    for (int i = 0; i < CHUNK_SIZE_; i++)
+        new (&chunk[i]) Counters();
+
+    /* Published only once constructed, for snapshots taken from other threads */
+    chunks_[pid >> CHUNK_BITS_].store(chunk, std::memory_order_release);
+
+    return chunk;
+}
+
+std::map<int, ProcessStats> ProcessStatsTable::snapshot() const
+{
+    std::map<int, ProcessStats> stats;
+
+    for (size_t c = 0; c < chunks_.size(); c++)
+    {
+        const Counters *chunk = chunks_[c].load(std::memory_order_acquire);
+
+        if (chunk == nullptr)
+            continue;
+
+        for (int i = 0; i < CHUNK_SIZE_; i++)
+        {
+            ProcessStats ps;
+            ps.page_fault_count = chunk[i].faults.load(std::memory_order_relaxed);
+            ps.eviction_count = chunk[i].evictions.load(std::memory_order_relaxed);
+            ps.sum_residency_time = chunk[i].residency.load(std::memory_order_relaxed);
+
+            if (ps.page_fault_count > 0 || ps.eviction_count > 0)
+                stats.insert(std::make_pair((int)(c << CHUNK_BITS_) + i, ps));
+        }
+    }
+
+    return stats;
+}
+} // namespace pager
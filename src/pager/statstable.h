@@ -0,0 +1,88 @@
+#ifndef H_STATSTABLE
+#define H_STATSTABLE
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace pager
+{
+struct ProcessStats;
+
+/**
+ * Fault, eviction and residency counters of every process, in dense arrays
+ * indexed by pid: recording is one indexed increment, with no lookup.
+ *
+ * The arrays are allocated in cache-aligned chunks of CHUNK_SIZE_ processes
+ * on first use and never move, and every counter is a 64-bit atomic, so
+ * snapshot() may be called from any thread while the owner keeps recording.
+ * A snapshot is exact per counter; counters of one process may be one
+ * reference apart. Only one thread may record at a time.
+ */
+class ProcessStatsTable
+{
+public:
+    ProcessStatsTable();
+    ~ProcessStatsTable();
+
+    void record_fault(int pid)
+    {
+        Counters &counters = counters_of(pid);
+        bump(counters.faults, 1);
+    }
+
+    void record_eviction(int pid, int64_t residency_time)
+    {
+        Counters &counters = counters_of(pid);
+        bump(counters.evictions, 1);
+        bump(counters.residency, residency_time);
+    }
+
+    /* Counters of every process that faulted or was evicted so far, by pid */
+    std::map<int, ProcessStats> snapshot() const;
+
+    static const int MAX_PID; /* pids range over [0, MAX_PID) */
+
+private:
+    /* Two processes per 64-byte line; a process never straddles two */
+    struct alignas(32) Counters
+    {
+        std::atomic<int64_t> faults;
+        std::atomic<int64_t> evictions;
+        std::atomic<int64_t> residency;
+
+        Counters() : faults(0), evictions(0), residency(0) {}
+    };
+
+    static const int CHUNK_BITS_ = 10;
+    static const int CHUNK_SIZE_ = 1 << CHUNK_BITS_;
+
+    Counters &counters_of(int pid)
+    {
+        Counters *chunk = ((unsigned)pid < (unsigned)MAX_PID)
+                              ? chunks_[pid >> CHUNK_BITS_].load(std::memory_order_acquire)
+                              : nullptr;
+
+        if (chunk == nullptr)
+            chunk = allocate_chunk(pid); /* exits if pid is out of range */
+
+        return chunk[pid & (CHUNK_SIZE_ - 1)];
+    }
+
+    /* Single writer: a plain load and store, without a locked read-modify-write */
+    static void bump(std::atomic<int64_t> &counter, int64_t delta)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+    }
+
+    Counters *allocate_chunk(int pid);
+
+    std::vector<std::atomic<Counters *>> chunks_;
+
+    ProcessStatsTable(const ProcessStatsTable &);
+    ProcessStatsTable &operator=(const ProcessStatsTable &);
+};
+} // namespace pager
+
+#endif
@@ -0,0 +1,169 @@
+#include "tlb.h"
+
+#include <iostream>
+
+#include "policy.h"
+
+namespace pager
+{
+Tlb::Tlb(const TlbConfig &config, int page_size, ReferenceSink &downstream)
+    : CONFIG_(config), PAGE_SIZE_(page_size), SET_COUNT_(config.entries / config.ways),
+      downstream_(downstream), entries_(config.entries), epoch_(1), clock_(0),
+      random_state_(0x9e3779b97f4a7c15ULL), flush_count_(0)
+{
+    for (auto &entry : entries_)
+    {
+        entry.tag = 0;
+        entry.epoch = 0;
+        entry.last_used = 0;
+    }
+}
+
+Tlb::Entry *Tlb::set_of(uint64_t tag)
+{
+    /* Indexed by the low bits of the virtual page number, as in hardware */
+    uint32_t page_id = (uint32_t)tag;
+    return &entries_[(page_id % SET_COUNT_) * CONFIG_.ways];
+}
+
+Tlb::Entry *Tlb::find(uint64_t tag)
+{
+    Entry *set = set_of(tag);
+
+    for (int way = 0; way < CONFIG_.ways; way++)
+    {
+        if (set[way].tag == tag && set[way].epoch == epoch_)
+            return &set[way];
+    }
+
+    return nullptr;
+}
+
+void Tlb::install(uint64_t tag)
+{
+    Entry *set = set_of(tag);
+    Entry *victim = nullptr;
+
+    for (int way = 0; way < CONFIG_.ways && !victim; way++)
+    {
+        if (set[way].epoch != epoch_)
+            victim = &set[way];
+    }
+
+    if (!victim && CONFIG_.replacement == TLB_RANDOM)
+    {
+        /* xorshift64*, private to the TLB so the simulation's random streams are untouched */
+        random_state_ ^= random_state_ >> 12;
+        random_state_ ^= random_state_ << 25;
+        random_state_ ^= random_state_ >> 27;
+        victim = &set[(random_state_ * 0x2545f4914f6cdd1dULL >> 32) % CONFIG_.ways];
+    }
+
+    if (!victim)
+    {
+        victim = &set[0];
+
+        for (int way = 1; way < CONFIG_.ways; way++)
+        {
+            if (set[way].last_used < victim->last_used)
+                victim = &set[way];
+        }
+    }
+
+    victim->tag = tag;
+    victim->epoch = epoch_;
+    victim->last_used = ++clock_;
+}
+
+void Tlb::reference_by_virtual_addr(int viraddr, int pid, int time_accessed)
+{
+    if ((int)counters_.size() <= pid)
+        counters_.resize(pid + 1, Counters{0, 0});
+
+    Counters &counters = counters_[pid];
+    counters.lookups++;
+
+    uint64_t tag = page_key(pid, viraddr / PAGE_SIZE_);
+    Entry *entry = find(tag);
+
+    if (entry)
+    {
+        entry->last_used = ++clock_;
+        downstream_.reference_by_virtual_addr(viraddr, pid, time_accessed);
+        return;
+    }
+
+    /* Page walk: the pager resolves the page (faulting it in if needed), then the translation is cached */
+    counters.misses++;
+    downstream_.reference_by_virtual_addr(viraddr, pid, time_accessed);
+    install(tag);
+}
+
+void Tlb::context_switch(int from_pid, int to_pid)
+{
+    if (CONFIG_.flush_on_switch && from_pid != to_pid)
+        flush();
+
+    downstream_.context_switch(from_pid, to_pid);
+}
+
+void Tlb::on_page_evicted(int pid, int page_id)
+{
+    Entry *entry = find(page_key(pid, page_id));
+
+    if (entry)
+        entry->epoch = 0;
+}
+
+void Tlb::flush()
+{
+    flush_count_++;
+
+    if (++epoch_ == 0)
+    {
+        /* Epochs wrapped: clear for real once every 2^32 flushes */
+        for (auto &entry : entries_)
+            entry.epoch = 0;
+
+        epoch_ = 1;
+    }
+}
+
+void Tlb::print_tlb_stats(std::ostream &stream) const
+{
+    stream << "\nTLB of " << CONFIG_.entries << " entries, " << CONFIG_.ways << "-way, "
+           << (CONFIG_.replacement == TLB_LRU ? "LRU" : "random") << " replacement, "
+           << (CONFIG_.flush_on_switch ? "flushed on context switch" : "tagged by process")
+           << " (" << flush_count_ << " flushes; " << CONFIG_.hit_cycles << " cycles per lookup, "
+           << CONFIG_.miss_cycles << " more per miss):" << std::endl;
+
+    Counters total = {0, 0};
+
+    for (size_t pid = 0; pid < counters_.size(); pid++)
+    {
+        const Counters &c = counters_[pid];
+
+        if (c.lookups == 0)
+            continue;
+
+        int64_t cycles = c.lookups * CONFIG_.hit_cycles + c.misses * CONFIG_.miss_cycles;
+
+        stream << "Process " << pid << " had " << c.lookups - c.misses << " TLB hits in "
+               << c.lookups << " references (hit rate " << (c.lookups - c.misses) / (double)c.lookups
+               << ") and " << cycles << " translation cycles (" << cycles / (double)c.lookups
+               << " per reference)." << std::endl;
+
+        total.lookups += c.lookups;
+        total.misses += c.misses;
+    }
+
+    if (total.lookups > 0)
+    {
+        int64_t cycles = total.lookups * CONFIG_.hit_cycles + total.misses * CONFIG_.miss_cycles;
+
+        stream << "The overall TLB hit rate is " << (total.lookups - total.misses) / (double)total.lookups
+               << " and translation takes " << cycles / (double)total.lookups
+               << " cycles per reference." << std::endl;
+    }
+}
+} // namespace pager
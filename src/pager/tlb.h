@@ -0,0 +1,90 @@
+#ifndef H_TLB
+#define H_TLB
+
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+#include "evictionlistener.h"
+#include "refsink.h"
+
+namespace pager
+{
+enum TlbReplacement
+{
+    TLB_LRU,
+    TLB_RANDOM
+};
+
+struct TlbConfig
+{
+    int entries;
+    int ways;            /* entries per set; entries for a fully associative TLB */
+    TlbReplacement replacement;
+    bool flush_on_switch; /* no address space ids: flush on every context switch */
+    int hit_cycles;       /* cycles of every lookup */
+    int miss_cycles;      /* extra cycles of a page walk */
+
+    TlbConfig()
+        : entries(0), ways(0), replacement(TLB_LRU), flush_on_switch(false),
+          hit_cycles(1), miss_cycles(30){};
+};
+
+/**
+ * Set-associative translation lookaside buffer in front of a pager. Every
+ * reference is looked up first and then forwarded; a miss installs the
+ * translation. Entries are tagged with the pid (the ASID), so without
+ * flush_on_switch translations of several processes coexist. Flushes bump an
+ * epoch instead of clearing every entry, so a context switch costs O(1).
+ * The pager reports evictions through EvictionListener so that a TLB hit
+ * always means the page is resident.
+ */
+class Tlb : public ReferenceSink, public EvictionListener
+{
+public:
+    Tlb(const TlbConfig &config, int page_size, ReferenceSink &downstream);
+
+    void reference_by_virtual_addr(int viraddr, int pid, int time_accessed) override;
+    void context_switch(int from_pid, int to_pid) override;
+    void on_page_evicted(int pid, int page_id) override;
+
+    void flush();
+
+    /* Hit rate and estimated translation cycles, per process and overall */
+    void print_tlb_stats(std::ostream &stream) const;
+
+private:
+    struct Entry
+    {
+        uint64_t tag;
+        uint32_t epoch;
+        uint64_t last_used;
+    };
+
+    struct Counters
+    {
+        int64_t lookups;
+        int64_t misses;
+    };
+
+    Entry *find(uint64_t tag);
+    void install(uint64_t tag);
+    Entry *set_of(uint64_t tag);
+
+    const TlbConfig CONFIG_;
+    const int PAGE_SIZE_;
+    const int SET_COUNT_;
+
+    ReferenceSink &downstream_;
+
+    std::vector<Entry> entries_;
+    uint32_t epoch_;
+    uint64_t clock_;
+    uint64_t random_state_;
+    int64_t flush_count_;
+
+    std::vector<Counters> counters_; /* indexed by pid */
+};
+} // namespace pager
+
+#endif
@@ -0,0 +1,282 @@
+#include "lockstep.h"
+
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <set>
+#include <sstream>
+
+#include "../driver/driver.h"
+#include "../io/randintreader.h"
+#include "../io/randsource.h"
+#include "../io/tracelog.h"
+#include "../pager/fanoutsink.h"
+#include "../pager/pager.h"
+#include "../pager/pagerfactory.h"
+#include "../trace/nextuse.h"
+#include "../trace/tracebuffer.h"
+#include "../trace/tracereader.h"
+#include "../trace/tracewriter.h"
+
+namespace sweep
+{
+
+namespace
+{
+
+/* Substream ids of the pagers' eviction streams, clear of the per-process ids */
+const uint64_t EVICTION_STREAM_BASE_ = 1ULL << 32;
+
+std::string column_name(const io::UserInput &config)
+{
+    return config.raw_algoname + "@" + std::to_string(config.machine_size);
+}
+
+std::unique_ptr<io::RandIntReader> eviction_reader(const io::UserInput &uin,
+                                                   const io::RandIntReader &shared, int column)
+{
+    std::unique_ptr<io::RandIntReader> reader = shared.substream(EVICTION_STREAM_BASE_ + column);
+
+    if (reader)
+        return reader;
+
+    /* The random number file cannot be split: read it from an offset of the column's own */
+    return std::unique_ptr<io::RandIntReader>(
+        new io::RandIntReader(io::make_random_source(uin, EVICTION_STREAM_BASE_ + column), false));
+}
+
+std::string format_cell(const pager::ProcessStats &stats)
+{
+    std::ostringstream cell;
+    cell << stats.page_fault_count << " / ";
+
+    if (stats.eviction_count > 0)
+        cell << (stats.sum_residency_time / (double)stats.eviction_count);
+    else
+        cell << "undefined";
+
+    return cell.str();
+}
+
+void reject_unsupported_options(const io::UserInput &uin)
+{
+    /* Reports kept in front of or beside a single pager, with no column to go in */
+
+    const char *option = nullptr;
+
+    if (uin.tlb.entries > 0)
+        option = "--tlb";
+    else if (uin.mrc != io::MRC_OFF)
+        option = "--mrc";
+    else if (uin.histograms)
+        option = "--histograms";
+    else if (uin.is_multicpu())
+        option = "--cpus";
+
+    if (option)
+    {
+        std::cout << option << " is not available with --compare. Terminating..." << std::endl;
+        exit(10);
+    }
+}
+
+void print_lockstep_table(const std::vector<io::UserInput> &configs,
+                          const std::vector<std::unique_ptr<pager::PagerBase>> &pagers)
+{
+    const int width = 20;
+
+    std::set<pager::pid> pids;
+
+    for (auto &pager : pagers)
+        for (auto &pstat : pager->process_stats())
+            pids.insert(pstat.first);
+
+    std::cout << "Faults / average residency, per process and overall:\n\n"
+              << std::left << std::setw(12) << "";
+
+    for (auto &config : configs)
+        std::cout << std::setw(width) << column_name(config);
+
+    std::cout << std::endl;
+
+    std::vector<pager::ProcessStats> totals(pagers.size());
+
+    for (pager::pid pid : pids)
+    {
+        std::cout << std::setw(12) << ("Process " + std::to_string(pid));
+
+        for (size_t i = 0; i < pagers.size(); i++)
+        {
+            const std::map<pager::pid, pager::ProcessStats> &stats = pagers[i]->process_stats();
+            auto found = stats.find(pid);
+            pager::ProcessStats pstat = (found == stats.end()) ? pager::ProcessStats() : found->second;
+
+            totals[i].page_fault_count += pstat.page_fault_count;
+            totals[i].eviction_count += pstat.eviction_count;
+            totals[i].sum_residency_time += pstat.sum_residency_time;
+
+            std::cout << std::setw(width) << format_cell(pstat);
+        }
+
+        std::cout << std::endl;
+    }
+
+    std::cout << std::setw(12) << "Total";
+
+    for (auto &total : totals)
+        std::cout << std::setw(width) << format_cell(total);
+
+    std::cout << std::endl;
+
+    if (pagers[0]->cost_model())
+    {
+        std::cout << std::setw(12) << "EAT cycles";
+
+        for (auto &pager : pagers)
+        {
+            std::ostringstream cell;
+            cell << std::fixed << std::setprecision(1) << pager->cost_model()->effective_access_time(-1);
+            std::cout << std::setw(width) << cell.str();
+        }
+
+        std::cout << std::endl;
+    }
+}
+
+} // namespace
+
+std::vector<io::UserInput> read_lockstep_list(const io::UserInput &uin)
+{
+    std::vector<io::UserInput> configs;
+    configs.push_back(uin);
+
+    std::istringstream iss(uin.lockstep);
+    std::string entry;
+
+    while (std::getline(iss, entry, ','))
+    {
+        if (entry.empty())
+            continue;
+
+        io::UserInput config = uin;
+        size_t at = entry.find('@');
+
+        config.raw_algoname = entry.substr(0, at);
+        config.algoname = io::map_to_algoname(config.raw_algoname);
+
+        if (at != std::string::npos)
+        {
+            config.machine_size = atoi(entry.substr(at + 1).c_str());
+
+            if (config.machine_size < config.page_size)
+            {
+                std::cout << "The machine size of `" << entry
+                          << "` must be at least the page size. Terminating..." << std::endl;
+                exit(10);
+            }
+        }
+
+        configs.push_back(config);
+    }
+
+    for (auto &config : configs)
+        config.debug = false;
+
+    return configs;
+}
+
+void execute_lockstep(const io::UserInput &uin)
+{
+    reject_unsupported_options(uin);
+
+    std::vector<io::UserInput> configs = read_lockstep_list(uin);
+
+    io::RandIntReader randintreader(io::make_random_source(uin), uin.showrand);
+
+    std::unique_ptr<trace::TraceReader> replay;
+
+    if (!uin.replay_trace.empty())
+    {
+        replay.reset(new trace::TraceReader(uin.replay_trace));
+
+        if (!replay->is_valid())
+        {
+            std::cout << "ERROR: Could not read trace file " << uin.replay_trace << "." << std::endl;
+            exit(10);
+        }
+    }
+
+    bool needs_stream = false;
+
+    for (auto &config : configs)
+        needs_stream = needs_stream || (config.algoname == pager::OPT);
+
+    /* OPT needs the whole stream up front: take it from the trace, or generate it first */
+
+    trace::TraceBuffer generated;
+    std::vector<uint64_t> next_use;
+
+    if (needs_stream)
+    {
+        if (replay)
+        {
+            next_use = trace::compute_next_use(replay->begin(), replay->end(), uin.page_size);
+        }
+        else
+        {
+            driver::Driver generator(uin, generated, randintreader);
+            generator.execute();
+            next_use = trace::compute_next_use(generated.begin(), generated.end(), uin.page_size);
+        }
+    }
+
+    std::vector<std::unique_ptr<io::RandIntReader>> readers;
+    std::vector<std::unique_ptr<pager::PagerBase>> pagers;
+    pager::FanOutSink fanout;
+
+    for (size_t i = 0; i < configs.size(); i++)
+    {
+        readers.push_back(eviction_reader(uin, randintreader, (int)i));
+        pagers.push_back(pager::make_pager(configs[i], *readers.back(), &next_use));
+        fanout.add(*pagers.back());
+    }
+
+    pager::ReferenceSink *sink = &fanout;
+    std::unique_ptr<trace::TraceWriter> recorder;
+
+    if (!uin.record_trace.empty())
+    {
+        recorder.reset(new trace::TraceWriter(uin.record_trace, sink));
+
+        if (!recorder->is_open())
+        {
+            std::cout << "ERROR: Could not create trace file " << uin.record_trace << "." << std::endl;
+            exit(10);
+        }
+
+        sink = recorder.get();
+    }
+
+    if (replay)
+    {
+        replay->replay(*sink);
+    }
+    else if (needs_stream)
+    {
+        generated.replay(*sink);
+    }
+    else
+    {
+        driver::Driver driver(uin, *sink, randintreader);
+        driver.execute();
+    }
+
+    if (recorder)
+        recorder->close();
+
+    io::trace_log().flush();
+    print_lockstep_table(configs, pagers);
+}
+
+} // namespace sweep
@@ -0,0 +1,29 @@
+#ifndef H_LOCKSTEP
+#define H_LOCKSTEP
+
+#include <vector>
+
+#include "../io/uin.h"
+
+namespace sweep
+{
+/**
+ * Configurations compared by lock-step mode: uin itself, then one per entry
+ * of uin.lockstep, `R` or `R@M` (algorithm, optionally with its own machine
+ * size). All share the page size and the workload of uin.
+ */
+std::vector<io::UserInput> read_lockstep_list(const io::UserInput &uin);
+
+/**
+ * Lock-step mode entry point: generates the reference stream of uin once and
+ * fans every reference out to one pager per configuration, then prints their
+ * statistics side by side. Each pager draws its eviction numbers from a
+ * stream of its own, so RANDOM does not perturb the reference generator.
+ * The stream may be replayed from or recorded to a trace; the TLB, miss ratio
+ * curves and histograms report on a single pager and are rejected.
+ */
+void execute_lockstep(const io::UserInput &uin);
+
+} // namespace sweep
+
+#endif
@@ -0,0 +1,88 @@
+#include "multicpu.h"
+
+#include <chrono>
+#include <iostream>
+
+#include "../driver/multicpudriver.h"
+#include "../io/randintreader.h"
+#include "../io/randsource.h"
+#include "../pager/shardedpager.h"
+
+namespace sweep
+{
+
+namespace
+{
+
+void reject_unsupported_options(const io::UserInput &uin)
+{
+    /* Reports and traces that assume a single pager fed one reference at a time */
+
+    const char *option = nullptr;
+
+    if (uin.tlb.entries > 0)
+        option = "--tlb";
+    else if (uin.mrc != io::MRC_OFF)
+        option = "--mrc";
+    else if (!uin.record_trace.empty())
+        option = "--record";
+    else if (!uin.replay_trace.empty())
+        option = "--replay";
+    else if (uin.histograms)
+        option = "--histograms";
+    else if (uin.cost.enabled)
+        option = "--cost";
+
+    if (option)
+    {
+        std::cout << option << " is not available with --cpus. Terminating..." << std::endl;
+        exit(10);
+    }
+}
+
+} // namespace
+
+void execute_multicpu(const io::UserInput &uin)
+{
+    if (uin.algoname == pager::OPT)
+    {
+        std::cout << "OPT needs the whole reference stream in advance and cannot run on several CPUs. Terminating..."
+                  << std::endl;
+        exit(10);
+    }
+
+    reject_unsupported_options(uin);
+
+    io::UserInput config = uin;
+    config.debug = false;
+    config.showrand = false;
+
+    /* Deterministic CPUs take turns, so the shards can draw from the shared stream like a single pager */
+
+    bool deterministic = (config.cpu_mode == io::CPU_DETERMINISTIC);
+    int shards = config.shards > 0 ? config.shards : 4 * config.cpus;
+
+    if (config.shards == 0)
+    {
+        std::cout << "Warning: replacement is local to each of the " << shards << " default shards, "
+                  << "which can fault far more often than one pager; use `--shards=1` to compare with a normal run."
+                  << std::endl;
+    }
+
+    io::RandIntReader randintreader(io::make_random_source(config), false);
+    pager::ShardedPager pager(config, randintreader, shards, deterministic);
+    driver::MultiCpuDriver driver(config, pager, randintreader);
+
+    auto start = std::chrono::steady_clock::now();
+    driver.execute();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    pager::print_process_stats(pager.process_stats());
+
+    std::cout << "\n" << driver.reference_count() << " references on " << driver.cpu_count() << " CPUs ("
+              << (deterministic ? "deterministic" : "relaxed") << ", " << pager.shard_count() << " shards) in "
+              << elapsed.count() * 1000.0 << " ms: " << (driver.reference_count() / elapsed.count())
+              << " references per second." << std::endl;
+}
+
+} // namespace sweep
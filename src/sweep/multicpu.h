@@ -0,0 +1,19 @@
+#ifndef H_MULTICPU
+#define H_MULTICPU
+
+#include "../io/uin.h"
+
+namespace sweep
+{
+/**
+ * Multi-CPU mode entry point: runs the workload of uin on uin.cpus simulated
+ * CPUs, one thread each (see driver::MultiCpuDriver), against a sharded
+ * pager, then prints the merged statistics and the reference throughput.
+ * Debug and show-random are off in this mode; the TLB, miss ratio curves,
+ * traces, histograms and cost model are rejected.
+ */
+void execute_multicpu(const io::UserInput &uin);
+
+} // namespace sweep
+
+#endif
@@ -0,0 +1,361 @@
+#include "sweep.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#include "threadpool.h"
+#include "../driver/driver.h"
+#include "../driver/jobmixspec.h"
+#include "../io/randintreader.h"
+#include "../io/randsource.h"
+#include "../pager/pagerfactory.h"
+#include "../trace/nextuse.h"
+#include "../trace/tracebuffer.h"
+
+namespace sweep
+{
+
+namespace
+{
+
+void validate_config(const io::UserInput &config, const std::string &origin)
+{
+    bool is_valid = config.machine_size > 0 && config.page_size > 0 &&
+                    config.machine_size >= config.page_size &&
+                    config.proc_size > 0 && config.ref_count >= 0 &&
+                    driver::jobmixspecs::get_jobmix(config.jobmix) != nullptr;
+
+    if (!is_valid)
+    {
+        std::cout << "Invalid sweep configuration (" << origin << "). Terminating..." << std::endl;
+        exit(10);
+    }
+}
+
+std::vector<std::string> split(const std::string &s, char delim)
+{
+    std::vector<std::string> parts;
+    std::istringstream iss(s);
+    std::string part;
+
+    while (std::getline(iss, part, delim))
+    {
+        if (!part.empty())
+            parts.push_back(part);
+    }
+
+    return parts;
+}
+
+std::vector<int> parse_int_values(const std::string &values)
+{
+    std::vector<int> result;
+
+    for (auto &value : split(values, ','))
+    {
+        std::vector<std::string> range = split(value, ':');
+
+        if (range.size() == 1)
+        {
+            result.push_back(std::stoi(range[0]));
+            continue;
+        }
+
+        int first = std::stoi(range[0]);
+        int last = std::stoi(range[1]);
+        int step = (range.size() >= 3) ? std::stoi(range[2]) : 1;
+
+        if (step <= 0)
+            throw std::invalid_argument("range step must be positive");
+
+        for (int v = first; v <= last; v += step)
+            result.push_back(v);
+    }
+
+    return result;
+}
+
+void reject_unsupported_options(const io::UserInput &uin)
+{
+    /* Every point runs one pager fed by a driver; the cost model is the only report with a column */
+
+    const char *option = nullptr;
+
+    if (uin.tlb.entries > 0)
+        option = "--tlb";
+    else if (uin.mrc != io::MRC_OFF)
+        option = "--mrc";
+    else if (!uin.record_trace.empty())
+        option = "--record";
+    else if (!uin.replay_trace.empty())
+        option = "--replay";
+    else if (uin.is_lockstep())
+        option = "--compare";
+    else if (uin.is_multicpu())
+        option = "--cpus";
+    else if (uin.histograms)
+        option = "--histograms";
+
+    if (option)
+    {
+        std::cout << option << " is not available with --sweep or --grid. Terminating..." << std::endl;
+        exit(10);
+    }
+}
+
+RunResult run_one(const io::UserInput &config, std::shared_ptr<const std::vector<int>> numbers)
+{
+    std::unique_ptr<io::RandomSource> source;
+
+    if (config.rng == io::RNG_FILE)
+        source.reset(new io::FileRandomSource(numbers));
+    else
+        source = io::make_random_source(config);
+
+    io::RandIntReader randintreader(std::move(source), false);
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::unique_ptr<pager::PagerBase> pager;
+
+    if (config.algoname == pager::OPT)
+    {
+        trace::TraceBuffer generated;
+        driver::Driver generator(config, generated, randintreader);
+        generator.execute();
+
+        std::vector<uint64_t> next_use = trace::compute_next_use(generated.begin(), generated.end(),
+                                                                 config.page_size);
+        pager = pager::make_pager(config, randintreader, &next_use);
+        generated.replay(*pager);
+    }
+    else
+    {
+        pager = pager::make_pager(config, randintreader);
+        driver::Driver driver(config, *pager, randintreader);
+        driver.execute();
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    RunResult result;
+    result.config = config;
+    result.process_stats = pager->process_stats();
+    result.seconds = elapsed.count();
+    result.effective_access_time = pager->cost_model() ? pager->cost_model()->effective_access_time(-1) : 0;
+    return result;
+}
+
+} // namespace
+
+std::vector<io::UserInput> read_sweep_list(const io::UserInput &uin)
+{
+    std::vector<io::UserInput> configs;
+    std::ifstream infile(uin.sweepfile);
+
+    if (!infile)
+    {
+        std::cout << "An error occured opening the sweep file. Terminating..." << std::endl;
+        exit(10);
+    }
+
+    std::string line;
+    int line_no = 0;
+
+    while (std::getline(infile, line))
+    {
+        line_no++;
+
+        if (line.find_first_not_of(" \t\r") == std::string::npos || line[0] == '#')
+            continue;
+
+        io::UserInput config = uin;
+        config.debug = false;
+        config.showrand = false;
+
+        if (!io::parse_input_line(line, config))
+        {
+            std::cout << "Sweep file corrupted at line " << line_no << ". Terminating..." << std::endl;
+            exit(10);
+        }
+
+        validate_config(config, "line " + std::to_string(line_no));
+        configs.push_back(config);
+    }
+
+    return configs;
+}
+
+std::vector<io::UserInput> expand_sweep_grid(const io::UserInput &uin)
+{
+    std::map<char, std::vector<int>> ints;
+    std::vector<std::string> algonames;
+
+    try
+    {
+        for (auto &entry : split(uin.sweepgrid, ';'))
+        {
+            size_t eq = entry.find('=');
+
+            if (eq != 1)
+                throw std::invalid_argument("expected <parameter>=<values> in `" + entry + "`");
+
+            char param = (char)toupper(entry[0]);
+            std::string values = entry.substr(2);
+
+            if (param == 'R')
+                algonames = split(values, ',');
+            else if (std::string("MPSJN").find(param) != std::string::npos)
+                ints[param] = parse_int_values(values);
+            else
+                throw std::invalid_argument(std::string("unknown parameter ") + param);
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::cout << "The sweep grid is not correct. Terminating..." << std::endl;
+        std::cerr << e.what() << '\n';
+        exit(10);
+    }
+
+    if (ints.size() != 5 || algonames.empty())
+    {
+        std::cout << "The sweep grid must give values for M, P, S, J, N and R. Terminating..." << std::endl;
+        exit(10);
+    }
+
+    std::vector<io::UserInput> configs;
+
+    for (int m : ints['M'])
+        for (int p : ints['P'])
+            for (int s : ints['S'])
+                for (int j : ints['J'])
+                    for (int n : ints['N'])
+                        for (auto &r : algonames)
+                        {
+                            io::UserInput config = uin;
+                            config.machine_size = m;
+                            config.page_size = p;
+                            config.proc_size = s;
+                            config.jobmix = j;
+                            config.ref_count = n;
+                            config.raw_algoname = r;
+                            config.algoname = io::map_to_algoname(r);
+                            config.debug = false;
+                            config.showrand = false;
+
+                            validate_config(config, "grid point " + std::to_string(configs.size() + 1));
+                            configs.push_back(config);
+                        }
+
+    return configs;
+}
+
+std::vector<RunResult> run_sweep(const std::vector<io::UserInput> &configs, int thread_count)
+{
+    std::shared_ptr<const std::vector<int>> numbers;
+
+    bool uses_file = std::any_of(configs.begin(), configs.end(),
+                                 [](const io::UserInput &c) { return c.rng == io::RNG_FILE; });
+
+    if (uses_file)
+    {
+        numbers = io::FileRandomSource::load(configs.front().randfile);
+
+        if (!numbers)
+        {
+            std::cout << "ERROR: Could not open rand-num file." << std::endl;
+            exit(10);
+        }
+    }
+
+    std::vector<RunResult> results(configs.size());
+    std::vector<std::function<void()>> tasks;
+
+    for (size_t i = 0; i < configs.size(); i++)
+    {
+        tasks.push_back([&results, &configs, numbers, i]() {
+            results[i] = run_one(configs[i], numbers);
+        });
+    }
+
+    ThreadPool pool(thread_count);
+    pool.run(std::move(tasks));
+
+    return results;
+}
+
+void print_sweep_table(const std::vector<RunResult> &results)
+{
+    /* Configurations share their options, so either all runs were costed or none */
+    bool costed = results[0].config.cost.enabled;
+
+    std::cout << std::left
+              << std::setw(6) << "#" << std::setw(8) << "M" << std::setw(6) << "P"
+              << std::setw(8) << "S" << std::setw(4) << "J" << std::setw(8) << "N"
+              << std::setw(8) << "R" << std::setw(10) << "faults" << std::setw(11) << "evictions"
+              << std::setw(15) << "avg-residency";
+
+    if (costed)
+        std::cout << std::setw(12) << "eat-cycles";
+
+    std::cout << "ms" << std::endl;
+
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const RunResult &r = results[i];
+
+        int64_t faults = 0;
+        int64_t evictions = 0;
+        int64_t residency = 0;
+
+        for (auto &pstat : r.process_stats)
+        {
+            faults += pstat.second.page_fault_count;
+            evictions += pstat.second.eviction_count;
+            residency += pstat.second.sum_residency_time;
+        }
+
+        std::ostringstream avg;
+
+        if (evictions > 0)
+            avg << (residency / (double)evictions);
+        else
+            avg << "undefined";
+
+        std::cout << std::setw(6) << (i + 1) << std::setw(8) << r.config.machine_size
+                  << std::setw(6) << r.config.page_size << std::setw(8) << r.config.proc_size
+                  << std::setw(4) << r.config.jobmix << std::setw(8) << r.config.ref_count
+                  << std::setw(8) << r.config.raw_algoname << std::setw(10) << faults
+                  << std::setw(11) << evictions << std::setw(15) << avg.str();
+
+        if (costed)
+            std::cout << std::setw(12) << std::fixed << std::setprecision(1) << r.effective_access_time;
+
+        std::cout << std::fixed << std::setprecision(3) << (r.seconds * 1000.0)
+                  << std::defaultfloat << std::endl;
+    }
+}
+
+void execute(const io::UserInput &uin)
+{
+    reject_unsupported_options(uin);
+
+    std::vector<io::UserInput> configs = uin.sweepfile.empty() ? expand_sweep_grid(uin)
+                                                               : read_sweep_list(uin);
+
+    if (configs.empty())
+    {
+        std::cout << "The sweep has no configurations." << std::endl;
+        return;
+    }
+
+    std::vector<RunResult> results = run_sweep(configs, uin.threads);
+    print_sweep_table(results);
+}
+
+} // namespace sweep
@@ -0,0 +1,45 @@
+#ifndef H_SWEEP
+#define H_SWEEP
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "../io/uin.h"
+#include "../pager/pager.h"
+
+namespace sweep
+{
+struct RunResult
+{
+    io::UserInput config;
+    std::map<pager::pid, pager::ProcessStats> process_stats;
+    double seconds;
+    double effective_access_time; /* cycles per reference; 0 without the cost model */
+};
+
+/* One configuration per `M P S J N R` line of uin.sweepfile. */
+std::vector<io::UserInput> read_sweep_list(const io::UserInput &uin);
+
+/**
+ * Cartesian product of uin.sweepgrid, e.g. `M=20,40;P=10;S=10;J=2:4;N=100;R=lru,fifo`.
+ * Every parameter takes a comma separated list of values; numeric values may
+ * also be ranges `first:last` or `first:last:step`.
+ */
+std::vector<io::UserInput> expand_sweep_grid(const io::UserInput &uin);
+
+/**
+ * Runs every configuration as an independent pager and driver on a
+ * work-stealing pool. Each run gets its own random stream cursor; the random
+ * number file is parsed once and shared. Results are in configuration order.
+ */
+std::vector<RunResult> run_sweep(const std::vector<io::UserInput> &configs, int thread_count);
+
+void print_sweep_table(const std::vector<RunResult> &results);
+
+/* Sweep mode entry point: reads the configurations in uin, runs and prints them. */
+void execute(const io::UserInput &uin);
+
+} // namespace sweep
+
+#endif
@@ -0,0 +1,79 @@
+#include "threadpool.h"
+
+#include <thread>
+
+namespace sweep
+{
+ThreadPool::ThreadPool(int thread_count)
+    : THREAD_COUNT_(thread_count > 0 ? thread_count
+                                     : (std::thread::hardware_concurrency() > 0 ? (int)std::thread::hardware_concurrency() : 1))
+{
+    for (int i = 0; i < THREAD_COUNT_; i++)
+        queues_.push_back(std::unique_ptr<WorkQueue>{new WorkQueue()});
+}
+
+int ThreadPool::thread_count() const
+{
+    return THREAD_COUNT_;
+}
+
+void ThreadPool::run(std::vector<std::function<void()>> tasks)
+{
+    for (size_t i = 0; i < tasks.size(); i++)
+        queues_[i % THREAD_COUNT_]->tasks.push_back(std::move(tasks[i]));
+
+    std::vector<std::thread> workers;
+
+    for (int i = 1; i < THREAD_COUNT_; i++)
+        workers.push_back(std::thread(&ThreadPool::work, this, i));
+
+    work(0);
+
+    for (auto &worker : workers)
+        worker.join();
+}
+
+void ThreadPool::work(int worker)
+{
+    /**
+     * No task submits further tasks, so once neither the local deque nor any
+     * other deque has work left, the worker is done.
+     */
+
+    std::function<void()> task;
+
+    while (pop_local(worker, task) || steal(worker, task))
+        task();
+}
+
+bool ThreadPool::pop_local(int worker, std::function<void()> &task)
+{
+    WorkQueue &queue = *queues_[worker];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+
+    if (queue.tasks.empty())
+        return false;
+
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool ThreadPool::steal(int thief, std::function<void()> &task)
+{
+    for (int i = 1; i < THREAD_COUNT_; i++)
+    {
+        WorkQueue &victim = *queues_[(thief + i) % THREAD_COUNT_];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+
+        if (victim.tasks.empty())
+            continue;
+
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        return true;
+    }
+
+    return false;
+}
+} // namespace sweep
@@ -0,0 +1,43 @@
+#ifndef H_THREADPOOL
+#define H_THREADPOOL
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace sweep
+{
+/**
+ * Work-stealing pool for independent tasks. Tasks are dealt round-robin onto
+ * per-worker deques; a worker pops from the back of its own deque and, once
+ * that is empty, steals from the front of the others'.
+ */
+class ThreadPool
+{
+public:
+    ThreadPool(int thread_count);
+
+    /* Runs every task and returns when all of them have finished. */
+    void run(std::vector<std::function<void()>> tasks);
+
+    int thread_count() const;
+
+private:
+    struct WorkQueue
+    {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    void work(int worker);
+    bool pop_local(int worker, std::function<void()> &task);
+    bool steal(int thief, std::function<void()> &task);
+
+    const int THREAD_COUNT_;
+    std::vector<std::unique_ptr<WorkQueue>> queues_;
+};
+} // namespace sweep
+
+#endif
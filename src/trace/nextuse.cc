@@ -0,0 +1,36 @@
+#include "nextuse.h"
+
+#include <unordered_map>
+
+namespace trace
+{
+
+std::vector<uint64_t> compute_next_use(const TraceRecord *begin, const TraceRecord *end, int page_size)
+{
+    uint64_t count = (uint64_t)(end - begin);
+    std::vector<uint64_t> next_use(count);
+    std::unordered_map<uint64_t, uint64_t> upcoming;
+
+    for (uint64_t i = count; i-- > 0;)
+    {
+        const TraceRecord &r = begin[i];
+        uint64_t key = ((uint64_t)(uint32_t)r.pid << 32) | (uint32_t)(r.viraddr / page_size);
+
+        auto found = upcoming.find(key);
+
+        if (found == upcoming.end())
+        {
+            next_use[i] = NEVER_USED;
+            upcoming.insert(std::make_pair(key, i));
+        }
+        else
+        {
+            next_use[i] = found->second;
+            found->second = i;
+        }
+    }
+
+    return next_use;
+}
+
+} // namespace trace
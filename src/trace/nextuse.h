@@ -0,0 +1,23 @@
+#ifndef H_NEXTUSE
+#define H_NEXTUSE
+
+#include <cstdint>
+#include <vector>
+
+#include "traceformat.h"
+
+namespace trace
+{
+/* Next-use position of a page that is never referenced again. */
+const uint64_t NEVER_USED = UINT64_MAX;
+
+/**
+ * For every record in [begin, end), the position of the next record that
+ * references the same page (pid, viraddr / page_size), or NEVER_USED.
+ * One backward pass over the stream.
+ */
+std::vector<uint64_t> compute_next_use(const TraceRecord *begin, const TraceRecord *end, int page_size);
+
+} // namespace trace
+
+#endif
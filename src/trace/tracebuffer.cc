@@ -0,0 +1,36 @@
+#include "tracebuffer.h"
+
+namespace trace
+{
+void TraceBuffer::reference_by_virtual_addr(int viraddr, int pid, int time_accessed)
+{
+    TraceRecord record;
+    record.pid = pid;
+    record.viraddr = viraddr;
+    record.time_accessed = time_accessed;
+
+    records_.push_back(record);
+}
+
+uint64_t TraceBuffer::size() const { return records_.size(); }
+
+const TraceRecord *TraceBuffer::begin() const { return records_.data(); }
+
+const TraceRecord *TraceBuffer::end() const { return records_.data() + records_.size(); }
+
+void TraceBuffer::replay(pager::ReferenceSink &sink) const
+{
+    /* Records carry no context switches: the driver made one wherever the pid changes */
+
+    const TraceRecord *previous = nullptr;
+
+    for (const TraceRecord *r = begin(); r != end(); r++)
+    {
+        if (previous && previous->pid != r->pid)
+            sink.context_switch(previous->pid, r->pid);
+
+        sink.reference_by_virtual_addr(r->viraddr, r->pid, r->time_accessed);
+        previous = r;
+    }
+}
+} // namespace trace
@@ -0,0 +1,30 @@
+#ifndef H_TRACEBUFFER
+#define H_TRACEBUFFER
+
+#include <cstdint>
+#include <vector>
+
+#include "traceformat.h"
+#include "../pager/refsink.h"
+
+namespace trace
+{
+/* Records the reference stream in memory, for policies that need it in advance. */
+class TraceBuffer : public pager::ReferenceSink
+{
+public:
+    void reference_by_virtual_addr(int viraddr, int pid, int time_accessed) override;
+
+    uint64_t size() const;
+    const TraceRecord *begin() const;
+    const TraceRecord *end() const;
+
+    /* Feeds every record, in order, to sink, with a context switch wherever the pid changes. */
+    void replay(pager::ReferenceSink &sink) const;
+
+private:
+    std::vector<TraceRecord> records_;
+};
+} // namespace trace
+
+#endif
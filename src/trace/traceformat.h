@@ -0,0 +1,42 @@
+#ifndef H_TRACEFORMAT
+#define H_TRACEFORMAT
+
+#include <cstdint>
+
+namespace trace
+{
+/**
+ * Binary reference trace: a fixed header followed by record_count fixed-size
+ * records, in reference order. Records are mapped in place, so all fields
+ * are in the byte order of the host that wrote them; byte_order holds
+ * TRACE_BYTE_ORDER in that order, and a host of the other order rejects the
+ * trace.
+ */
+
+struct TraceHeader
+{
+    char magic[8]; /* "PGTRACE1" */
+    uint32_t version;
+    uint32_t record_size;
+    uint64_t record_count;
+    uint32_t byte_order;
+    uint32_t reserved;
+};
+
+struct TraceRecord
+{
+    int32_t pid;
+    int32_t viraddr;
+    int32_t time_accessed;
+};
+
+const char TRACE_MAGIC[8] = {'P', 'G', 'T', 'R', 'A', 'C', 'E', '1'};
+const uint32_t TRACE_VERSION = 1;
+const uint32_t TRACE_BYTE_ORDER = 0x01020304;
+
+static_assert(sizeof(TraceHeader) == 32, "trace header must be packed");
+static_assert(sizeof(TraceRecord) == 12, "trace record must be packed");
+
+} // namespace trace
+
+#endif
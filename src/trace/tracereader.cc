@@ -0,0 +1,84 @@
+#include "tracereader.h"
+
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../pager/refsink.h"
+
+namespace trace
+{
+TraceReader::TraceReader(const std::string &path)
+    : fd_(-1), map_(nullptr), map_size_(0), records_(nullptr), record_count_(0)
+{
+    fd_ = open(path.c_str(), O_RDONLY);
+
+    struct stat status;
+
+    if (fd_ < 0 || fstat(fd_, &status) != 0 || (size_t)status.st_size < sizeof(TraceHeader))
+        return;
+
+    map_size_ = (size_t)status.st_size;
+    map_ = mmap(nullptr, map_size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+
+    if (map_ == MAP_FAILED)
+    {
+        map_ = nullptr;
+        return;
+    }
+
+    madvise(map_, map_size_, MADV_SEQUENTIAL);
+
+    TraceHeader header;
+    memcpy(&header, map_, sizeof(header));
+
+    bool is_trace = memcmp(header.magic, TRACE_MAGIC, sizeof(TRACE_MAGIC)) == 0 &&
+                    header.byte_order == TRACE_BYTE_ORDER &&
+                    header.version == TRACE_VERSION &&
+                    header.record_size == sizeof(TraceRecord) &&
+                    sizeof(TraceHeader) + header.record_count * sizeof(TraceRecord) <= map_size_;
+
+    if (is_trace)
+    {
+        records_ = reinterpret_cast<const TraceRecord *>(static_cast<const char *>(map_) + sizeof(TraceHeader));
+        record_count_ = header.record_count;
+    }
+}
+
+TraceReader::~TraceReader()
+{
+    if (map_)
+        munmap(map_, map_size_);
+    if (fd_ >= 0)
+        close(fd_);
+}
+
+bool TraceReader::is_valid() const { return records_ != nullptr; }
+
+uint64_t TraceReader::size() const { return record_count_; }
+
+const TraceRecord &TraceReader::operator[](uint64_t i) const { return records_[i]; }
+
+const TraceRecord *TraceReader::begin() const { return records_; }
+
+const TraceRecord *TraceReader::end() const { return records_ + record_count_; }
+
+void TraceReader::replay(pager::ReferenceSink &sink) const
+{
+    /* Records carry no context switches: the driver made one wherever the pid changes */
+
+    const TraceRecord *previous = nullptr;
+
+    for (const TraceRecord *r = begin(); r != end(); r++)
+    {
+        if (previous && previous->pid != r->pid)
+            sink.context_switch(previous->pid, r->pid);
+
+        sink.reference_by_virtual_addr(r->viraddr, r->pid, r->time_accessed);
+        previous = r;
+    }
+}
+} // namespace trace
@@ -0,0 +1,49 @@
+#ifndef H_TRACEREADER
+#define H_TRACEREADER
+
+#include <cstdint>
+#include <string>
+
+#include "traceformat.h"
+
+namespace pager
+{
+class ReferenceSink;
+}
+
+namespace trace
+{
+/**
+ * Read-only, memory-mapped view of a binary trace. Records are read in place,
+ * so replaying a trace streams straight from the page cache.
+ */
+class TraceReader
+{
+public:
+    TraceReader(const std::string &path);
+    ~TraceReader();
+
+    /* False if the file is missing, truncated, not a trace or of the other byte order. */
+    bool is_valid() const;
+
+    uint64_t size() const;
+    const TraceRecord &operator[](uint64_t i) const;
+    const TraceRecord *begin() const;
+    const TraceRecord *end() const;
+
+    /* Feeds every record, in order, to sink, with a context switch wherever the pid changes. */
+    void replay(pager::ReferenceSink &sink) const;
+
+private:
+    TraceReader(const TraceReader &);
+    TraceReader &operator=(const TraceReader &);
+
+    int fd_;
+    void *map_;
+    size_t map_size_;
+    const TraceRecord *records_;
+    uint64_t record_count_;
+};
+} // namespace trace
+
+#endif
@@ -0,0 +1,109 @@
+#include "tracewriter.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+namespace trace
+{
+const size_t TraceWriter::BUFFER_RECORDS_ = 1 << 16;
+
+TraceWriter::TraceWriter(const std::string &path, pager::ReferenceSink *downstream)
+    : path_(path), downstream_(downstream), record_count_(0)
+{
+    out_ = fopen(path.c_str(), "wb");
+    buffer_.reserve(BUFFER_RECORDS_);
+
+    if (out_)
+    {
+        /* Placeholder header; the record count is written by close() */
+        TraceHeader header;
+        memset(&header, 0, sizeof(header));
+        write(&header, sizeof(header), 1);
+    }
+}
+
+TraceWriter::~TraceWriter()
+{
+    close();
+}
+
+bool TraceWriter::is_open() const
+{
+    return out_ != nullptr;
+}
+
+void TraceWriter::reference_by_virtual_addr(int viraddr, int pid, int time_accessed)
+{
+    TraceRecord record;
+    record.pid = pid;
+    record.viraddr = viraddr;
+    record.time_accessed = time_accessed;
+
+    buffer_.push_back(record);
+
+    if (buffer_.size() == BUFFER_RECORDS_)
+        flush();
+
+    if (downstream_)
+        downstream_->reference_by_virtual_addr(viraddr, pid, time_accessed);
+}
+
+void TraceWriter::context_switch(int from_pid, int to_pid)
+{
+    if (downstream_)
+        downstream_->context_switch(from_pid, to_pid);
+}
+
+void TraceWriter::flush()
+{
+    if (out_ && !buffer_.empty())
+    {
+        write(&buffer_[0], sizeof(TraceRecord), buffer_.size());
+        record_count_ += buffer_.size();
+    }
+
+    buffer_.clear();
+}
+
+void TraceWriter::close()
+{
+    if (!out_)
+        return;
+
+    flush();
+
+    TraceHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, TRACE_MAGIC, sizeof(TRACE_MAGIC));
+    header.version = TRACE_VERSION;
+    header.record_size = sizeof(TraceRecord);
+    header.record_count = record_count_;
+    header.byte_order = TRACE_BYTE_ORDER;
+
+    if (fseek(out_, 0, SEEK_SET) != 0)
+        fail();
+
+    write(&header, sizeof(header), 1);
+
+    bool closed = (fflush(out_) == 0 && !ferror(out_));
+    closed = (fclose(out_) == 0) && closed;
+    out_ = nullptr;
+
+    if (!closed)
+        fail();
+}
+
+void TraceWriter::write(const void *data, size_t size, size_t count)
+{
+    if (fwrite(data, size, count, out_) != count || ferror(out_))
+        fail();
+}
+
+void TraceWriter::fail()
+{
+    /* A truncated trace would still be accepted by --replay; do not leave one behind silently */
+    std::cout << "An error occured writing the trace file `" << path_ << "`. Terminating..." << std::endl;
+    exit(10);
+}
+} // namespace trace
@@ -0,0 +1,49 @@
+#ifndef H_TRACEWRITER
+#define H_TRACEWRITER
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "traceformat.h"
+#include "../pager/refsink.h"
+
+namespace trace
+{
+/**
+ * Records every reference it sees to a binary trace file, then forwards it to
+ * the downstream sink, if any. Records are buffered and written in large
+ * blocks; the record count in the header is filled in by close().
+ */
+class TraceWriter : public pager::ReferenceSink
+{
+public:
+    TraceWriter(const std::string &path, pager::ReferenceSink *downstream);
+    ~TraceWriter();
+
+    bool is_open() const;
+    void reference_by_virtual_addr(int viraddr, int pid, int time_accessed) override;
+    void context_switch(int from_pid, int to_pid) override;
+    void close();
+
+private:
+    TraceWriter(const TraceWriter &);
+    TraceWriter &operator=(const TraceWriter &);
+
+    void flush();
+
+    /* fwrite that terminates on a short write or a stream error */
+    void write(const void *data, size_t size, size_t count);
+    void fail();
+
+    static const size_t BUFFER_RECORDS_;
+
+    std::string path_;
+    FILE *out_;
+    pager::ReferenceSink *downstream_;
+    std::vector<TraceRecord> buffer_;
+    uint64_t record_count_;
+};
+} // namespace trace
+
+#endif